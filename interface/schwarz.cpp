@@ -432,15 +432,15 @@ int main(int argc, char **argv) {
             A.callNumfact();
             /*# FactorizationEnd #*/
             /*# Solution #*/
-            unsigned short it = 100;
-            unsigned short restart = 30;
+            HPDDM::index_type it = 100;
+            HPDDM::index_type restart = 30;
             HPDDM::IterativeMethod::GMRES(A, sol, f, restart, it, eps, A.getCommunicator(), rankWorld == 0 ? 1 : 0);
             /*# SolutionEnd #*/
         }
         else {
             A.setType(1);
             A.callNumfact();
-            unsigned short it = 100;
+            HPDDM::index_type it = 100;
             HPDDM::IterativeMethod::CG(A, sol, f, it, eps, A.getCommunicator(), rankWorld == 0 ? 1 : 0);
         }
         timing = MPI_Wtime() - timing;
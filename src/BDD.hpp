@@ -57,11 +57,21 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             _m = new typename Wrapper<K>::ul_type[Subdomain<K>::_dof];
         }
         inline void allocateSingle(K*& primal) const {
-            primal = new K[Subdomain<K>::_dof];
+            primal = Workspace::get<K>(Subdomain<K>::_dof);
+        }
+        /* Function: allocateBlock
+         *
+         *  Allocates a block of contiguous vectors of size <Subdomain::dof>.
+         *
+         * Parameters:
+         *    primal         - Reference to a block of vectors.
+         *    mu             - Number of vectors. */
+        inline void allocateBlock(K*& primal, const unsigned short& mu) const {
+            primal = Workspace::get<K>(mu * Subdomain<K>::_dof);
         }
         template<unsigned short N>
         inline void allocateArray(K* (&array)[N]) const {
-            *array = new K[N * Subdomain<K>::_dof];
+            *array = Workspace::get<K>(N * Subdomain<K>::_dof);
             for(unsigned short i = 1; i < N; ++i)
                 array[i] = *array + i * Subdomain<K>::_dof;
         }
@@ -141,6 +151,65 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                 std::fill(x, x + Subdomain<K>::_dof, K());
             }
         }
+        /* Function: start(n)
+         *
+         *  Block Projected Conjugate Gradient initialization, with a single coarse solve for all right-hand sides.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    x              - Solution vectors, with leading dimension <Subdomain::a>->_n.
+         *    f              - Right-hand sides.
+         *    b              - Condensed right-hand sides (optional).
+         *    r              - First residuals.
+         *    mu             - Number of vectors. */
+        template<bool excluded>
+        inline void start(K* const x, const K* const f, K* const b, K* const r, const unsigned short& mu) const {
+            if(super::_co) {
+                K* const uc = Workspace::get<K>(mu * super::_co->getSizeRHS());
+                if(!excluded) {
+                    const int size = mu * Subdomain<K>::_dof;
+                    K* const work = Workspace::get<K>(b ? size : 2 * size);
+                    K* const c = b ? b : work + size;
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        super::condensateEffort(f + nu * Subdomain<K>::_a->_n, c + nu * Subdomain<K>::_dof);
+                    Subdomain<K>::exchange(c, mu);
+                    if(super::_ev) {
+                        const int m = mu;
+                        const int ld = super::_schur ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                        const K* const ev = super::_schur ? *super::_ev : *super::_ev + super::_bi->_m;
+                        Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _m, c, work);
+                        Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &(Subdomain<K>::_dof), ev, &ld, &(Wrapper<K>::d__0), uc, &m);
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, &ld, uc, &m, &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                        Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _m, work, work);
+                    }
+                    else {
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        std::fill_n(work, size, K());
+                    }
+                    Subdomain<K>::exchange(work, mu);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        std::copy_n(work + nu * Subdomain<K>::_dof, Subdomain<K>::_dof, x + nu * Subdomain<K>::_a->_n);
+                    super::applyLocalSchurComplement(work, mu);
+                    Subdomain<K>::exchange(work, mu);
+                    for(int i = 0; i < size; ++i)
+                        r[i] = c[i] - work[i];
+                    Workspace::release(work);
+                }
+                else
+                    super::_co->template callSolver<excluded>(uc, 0, mu);
+                Workspace::release(uc);
+            }
+            else if(!excluded) {
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    super::condensateEffort(f + nu * Subdomain<K>::_a->_n, r + nu * Subdomain<K>::_dof);
+                    std::fill_n(x + nu * Subdomain<K>::_a->_n, Subdomain<K>::_dof, K());
+                }
+                Subdomain<K>::exchange(r, mu);
+            }
+        }
         /* Function: apply
          *
          *  Applies the global Schur complement to a single right-hand side.
@@ -158,6 +227,19 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                 Subdomain<K>::exchange(in);
             }
         }
+        /* Function: apply(n)
+         *
+         *  Applies the global Schur complement to multiple right-hand sides.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        inline void apply(const K* const in, K* const out, const unsigned short& mu) const {
+            std::copy_n(in, mu * Subdomain<K>::_dof, out);
+            super::applyLocalSchurComplement(out, mu);
+            Subdomain<K>::exchange(out, mu);
+        }
         /* Function: precond
          *
          *  Applies the global preconditioner to a single right-hand side.
@@ -182,6 +264,31 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                 Subdomain<K>::exchange(in);
             }
         }
+        /* Function: precond(n)
+         *
+         *  Applies the global preconditioner to multiple right-hand sides.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        inline void precond(const K* const in, K* const out, const unsigned short& mu) const {
+            K* const work = Workspace::get<K>(mu * Subdomain<K>::_a->_n);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, in + nu * Subdomain<K>::_dof, work + nu * Subdomain<K>::_a->_n + super::_bi->_m);
+            if(!HPDDM_QR || !super::_schur) {
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::fill_n(work + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                static_cast<Solver<K>*>(super::_pinv)->solve(work, mu);
+            }
+            else
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    static_cast<QR<K>*>(super::_pinv)->solve(work + nu * Subdomain<K>::_a->_n + super::_bi->_m);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, work + nu * Subdomain<K>::_a->_n + super::_bi->_m, out + nu * Subdomain<K>::_dof);
+            Workspace::release(work);
+            Subdomain<K>::exchange(out, mu);
+        }
         /* Function: callNumfact
          *  Factorizes <Subdomain::a> or <Schur::schur> if available. */
         inline void callNumfact() {
@@ -249,6 +356,61 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             else if(!excluded && out)
                 std::copy(in, in + Subdomain<K>::_dof, out);
         }
+        /* Function: project(n)
+         *
+         *  Projects multiple vectors into the coarse space with a single coarse solve.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    trans          - 'T' if the transposed projection should be applied, 'N' otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors, nullptr if the projection is performed in-place.
+         *    mu             - Number of vectors. */
+        template<bool excluded, char trans>
+        inline void project(K* const in, K* const out, const unsigned short& mu) const {
+            static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(super::_co) {
+                K* const uc = Workspace::get<K>(mu * super::_co->getSizeRHS());
+                if(!excluded) {
+                    const int size = mu * Subdomain<K>::_dof;
+                    K* const work = Workspace::get<K>(size);
+                    if(trans == 'N')
+                        apply(in, work, mu);
+                    if(super::_ev) {
+                        const int m = mu;
+                        const int ld = super::_schur ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                        const K* const ev = super::_schur ? *super::_ev : *super::_ev + super::_bi->_m;
+                        Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _m, trans == 'N' ? work : in, work);
+                        Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), work, &(Subdomain<K>::_dof), ev, &ld, &(Wrapper<K>::d__0), uc, &m);
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, &ld, uc, &m, &(Wrapper<K>::d__0), work, &(Subdomain<K>::_dof));
+                    }
+                    else {
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        std::fill_n(work, size, K());
+                    }
+                    Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _m, work, work);
+                    Subdomain<K>::exchange(work, mu);
+                    if(trans == 'T') {
+                        super::applyLocalSchurComplement(work, mu);
+                        Subdomain<K>::exchange(work, mu);
+                    }
+                    if(out)
+                        for(int i = 0; i < size; ++i)
+                            out[i] = in[i] - work[i];
+                    else
+                        Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), work, &i__1, in, &i__1);
+                    Workspace::release(work);
+                }
+                else
+                    super::_co->template callSolver<excluded>(uc, 0, mu);
+                Workspace::release(uc);
+            }
+            else if(!excluded && out)
+                std::copy_n(in, mu * Subdomain<K>::_dof, out);
+        }
         /* Function: buildTwo
          *
          *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>.
@@ -293,6 +455,34 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         template<bool>
         inline void computeSolution(K* const, K* const* const) const { }
+        /* Function: computeSolution(n)
+         *
+         *  Computes multiple solutions after convergence of the block Projected Conjugate Gradient, with a single multiple right-hand side local solve.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    x              - Solution vectors.
+         *    f              - Right-hand sides.
+         *    mu             - Number of vectors. */
+        template<bool excluded>
+        inline void computeSolution(K* const x, const K* const f, const unsigned short& mu) const {
+            if(!excluded) {
+                const int m = mu;
+                const int ld = super::_schur ? Subdomain<K>::_a->_n : super::_bi->_m;
+                K* const work = Workspace::get<K>(mu * ld);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(f + nu * Subdomain<K>::_a->_n, super::_bi->_m, work + nu * ld);
+                Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &m, &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, x + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__1), work, &ld);
+                super::_s.solve(work, mu);
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    std::copy_n(work + nu * ld, super::_bi->_m, x + nu * Subdomain<K>::_a->_n);
+                Workspace::release(work);
+            }
+        }
+        template<bool>
+        inline void computeSolution(K* const, K* const* const, const unsigned short&) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two vectors.
@@ -302,16 +492,19 @@ class Bdd : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    mu             - Number of vectors in a and b (optional). */
         template<bool excluded>
-        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const a, const K* const b, const MPI_Comm& comm) const {
-            if(!excluded) {
-                Wrapper<K>::diagv(Subdomain<K>::_dof, _m, a, super::_work);
-                *val = Wrapper<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b, &i__1);
+        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const a, const K* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                if(!excluded) {
+                    Wrapper<K>::diagv(Subdomain<K>::_dof, _m, a + nu * Subdomain<K>::_dof, super::_work);
+                    val[nu] = Wrapper<K>::dot(&(Subdomain<K>::_dof), super::_work, &i__1, b + nu * Subdomain<K>::_dof, &i__1);
+                }
+                else
+                    val[nu] = 0.0;
             }
-            else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Bdd::m>. */
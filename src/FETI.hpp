@@ -72,22 +72,69 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
                         primal[Subdomain<K>::_map[i].second[j]] += scale ? _m[i][j] * dual[i][j] : dual[i][j];
             }
             else {
+#if !HPDDM_NEIGHBORHOOD
+                MPI_Startall(Subdomain<K>::_map.size(), Subdomain<K>::_persistent);
+#endif
                 for(unsigned short i = 0; i < super::_signed; ++i) {
-                    MPI_Irecv(Subdomain<K>::_rbuff[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
                     for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        dual[i][j] = -(scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
-                    MPI_Isend(dual[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                        Subdomain<K>::_sbuff[i][j] = -(scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
+#if !HPDDM_NEIGHBORHOOD
+                    MPI_Start(Subdomain<K>::_persistent + Subdomain<K>::_map.size() + i);
+#endif
                 }
                 for(unsigned short i = super::_signed; i < Subdomain<K>::_map.size(); ++i) {
-                    MPI_Irecv(Subdomain<K>::_rbuff[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + i);
                     for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
-                        dual[i][j] =  (scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
-                    MPI_Isend(dual[i], Subdomain<K>::_map[i].second.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_map[i].first, 0, Subdomain<K>::_communicator, Subdomain<K>::_rq + Subdomain<K>::_map.size() + i);
+                        Subdomain<K>::_sbuff[i][j] =  (scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j]] : primal[Subdomain<K>::_map[i].second[j]]);
+#if !HPDDM_NEIGHBORHOOD
+                    MPI_Start(Subdomain<K>::_persistent + Subdomain<K>::_map.size() + i);
+#endif
                 }
-                MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_rq, MPI_STATUSES_IGNORE);
+                if(super::_mult)
+                    std::copy_n(Subdomain<K>::_sbuff[0], super::_mult, *dual);
+#if HPDDM_NEIGHBORHOOD
+                MPI_Neighbor_alltoallv(super::_mult ? Subdomain<K>::_sbuff[0] : nullptr, Subdomain<K>::_counts, Subdomain<K>::_counts + Subdomain<K>::_map.size(), Wrapper<K>::mpi_type(), super::_mult ? Subdomain<K>::_rbuff[0] : nullptr, Subdomain<K>::_counts, Subdomain<K>::_counts + Subdomain<K>::_map.size(), Wrapper<K>::mpi_type(), Subdomain<K>::_graph);
+#else
+                MPI_Waitall(2 * Subdomain<K>::_map.size(), Subdomain<K>::_persistent, MPI_STATUSES_IGNORE);
+#endif
                 Wrapper<K>::axpy(&(super::_mult), &(Wrapper<K>::d__1), Subdomain<K>::_rbuff[0], &i__1, *dual, &i__1);
             }
         }
+        /* Function: A(n)
+         *
+         *  Jump operator applied to multiple vectors. The values sent to each neighbor are interleaved and exchanged with <Subdomain::transfer>.
+         *
+         * Template Parameters:
+         *    trans          - 'T' if the transposed jump operator should be applied, 'N' otherwise.
+         *    scale          - True if the unknowns should be scale by <Feti::m>, false otherwise.
+         *
+         * Parameters:
+         *    primal         - Primal unknowns.
+         *    dual           - Dual unknowns, see <Feti::allocateBlock>.
+         *    mu             - Number of vectors.
+         *    ld             - Leading dimension of primal. */
+        template<char trans, bool scale>
+        inline void A(K* const primal, K* const* const dual, const unsigned short& mu, const int& ld) const {
+            static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(trans == 'T')
+                for(unsigned short nu = 0; nu < mu; ++nu)
+                    A<'T', scale>(primal + nu * ld, dual + nu * Subdomain<K>::_map.size());
+            else {
+                Subdomain<K>::template transfer<K>(mu, [&](const unsigned short i, K* out) {
+                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
+                        for(unsigned short nu = 0; nu < mu; ++nu, ++out) {
+                            K& d = dual[i + nu * Subdomain<K>::_map.size()][j];
+                            d = (scale ? _m[i][j] * primal[Subdomain<K>::_map[i].second[j] + nu * ld] : primal[Subdomain<K>::_map[i].second[j] + nu * ld]);
+                            if(i < super::_signed)
+                                d = -d;
+                            *out = d;
+                        }
+                }, [&](const unsigned short i, const K* in) {
+                    for(unsigned int j = 0; j < Subdomain<K>::_map[i].second.size(); ++j)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            dual[i + nu * Subdomain<K>::_map.size()][j] += *in++;
+                });
+            }
+        }
         template<class U, typename std::enable_if<std::is_same<U, typename Wrapper<U>::ul_type>::value>::type* = nullptr>
         inline void allocate(U**& dual, typename Wrapper<U>::ul_type**& m) {
             static_assert(std::is_same<U, K>::value, "Wrong types");
@@ -185,6 +232,73 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             else if(super::_co)
                 project<excluded, 'T'>(r);
         }
+        /* Function: start(n)
+         *
+         *  Block Projected Conjugate Gradient initialization, with a single coarse solve for all right-hand sides.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    x              - Solution vectors.
+         *    f              - Right-hand sides.
+         *    l              - Lagrange multipliers, see <Feti::allocateBlock>.
+         *    r              - First residuals, see <Feti::allocateBlock>.
+         *    mu             - Number of vectors. */
+        template<bool excluded>
+        inline void start(K* const x, const K* const f, K* const* const l, K* const* const r, const unsigned short& mu) const {
+            Solver<K>* p = static_cast<Solver<K>*>(super::_pinv);
+            if(super::_co) {
+                K* const uc = Workspace::get<K>(mu * super::_co->getSizeRHS());
+                if(!excluded) {
+                    const int size = mu * Subdomain<K>::_a->_n;
+                    K* const work = Workspace::get<K>(size);
+                    K* const primal = Workspace::get<K>(mu * Subdomain<K>::_dof);
+                    if(super::_ev) {
+                        const int m = mu;
+                        const int ld = super::_schur ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                        const K* const ev = super::_schur ? *super::_ev : *super::_ev + super::_bi->_m;
+                        if(super::_schur) {
+                            for(unsigned short nu = 0; nu < mu; ++nu) {
+                                super::condensateEffort(f + nu * Subdomain<K>::_a->_n, nullptr);
+                                std::copy_n(_primal, Subdomain<K>::_dof, primal + nu * Subdomain<K>::_dof);
+                            }
+                            Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), primal, &(Subdomain<K>::_dof), ev, &ld, &(Wrapper<K>::d__0), uc, &m);
+                        }
+                        else
+                            Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__1), f, &(Subdomain<K>::_a->_n), *super::_ev, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), uc, &m);
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, &ld, uc, &m, &(Wrapper<K>::d__0), primal, &(Subdomain<K>::_dof));
+                    }
+                    else {
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        std::fill_n(primal, mu * Subdomain<K>::_dof, K());
+                    }
+                    A<'N', 0>(primal, l, mu, Subdomain<K>::_dof);
+                    precond(l, l, mu);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        std::fill_n(work + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                    A<'T', 0>(work + super::_bi->_m, l, mu, Subdomain<K>::_a->_n);
+                    p->solve(work, mu);
+                    std::copy_n(f, size, x);
+                    p->solve(x, mu);
+                    Wrapper<K>::axpby(size, 1.0, x, 1, -1.0, work, 1);
+                    A<'N', 0>(work + super::_bi->_m, r, mu, Subdomain<K>::_a->_n);
+                    Workspace::release(primal);
+                    Workspace::release(work);
+                }
+                else
+                    super::_co->template callSolver<excluded>(uc, 0, mu);
+                Workspace::release(uc);
+                project<excluded, 'T'>(r, nullptr, mu);
+            }
+            else if(!excluded) {
+                std::copy_n(f, mu * Subdomain<K>::_a->_n, x);
+                p->solve(x, mu);
+                A<'N', 0>(x + super::_bi->_m, r, mu, Subdomain<K>::_a->_n);
+                std::fill_n(*l, mu * super::_mult, K());
+            }
+        }
         /* Function: allocateSingle
          *
          *  Allocates a single Lagrange multiplier.
@@ -193,10 +307,26 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    mult           - Reference to a Lagrange multiplier. */
         inline void allocateSingle(K**& mult) const {
             mult  = new K*[Subdomain<K>::_map.size()];
-            *mult = new K[super::_mult];
+            *mult = Workspace::get<K>(super::_mult);
             for(unsigned short i = 1; i < Subdomain<K>::_map.size(); ++i)
                 mult[i] = mult[i - 1] + Subdomain<K>::_map[i - 1].second.size();
         }
+        /* Function: allocateBlock
+         *
+         *  Allocates a block of contiguous Lagrange multipliers, the i-th one starting at mult + i * <Subdomain::map>.size().
+         *
+         * Parameters:
+         *    mult           - Reference to a block of Lagrange multipliers.
+         *    mu             - Number of Lagrange multipliers. */
+        inline void allocateBlock(K**& mult, const unsigned short& mu) const {
+            mult  = new K*[mu * Subdomain<K>::_map.size()];
+            *mult = Workspace::get<K>(mu * super::_mult);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                mult[nu * Subdomain<K>::_map.size()] = *mult + nu * super::_mult;
+                for(unsigned short i = 1; i < Subdomain<K>::_map.size(); ++i)
+                    mult[nu * Subdomain<K>::_map.size() + i] = mult[nu * Subdomain<K>::_map.size() + i - 1] + Subdomain<K>::_map[i - 1].second.size();
+            }
+        }
         /* Function: allocateArray
          *
          *  Allocates an array of multiple Lagrange multipliers.
@@ -209,7 +339,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         template<unsigned short N>
         inline void allocateArray(K** (&array)[N]) const {
             *array  = new K*[N * Subdomain<K>::_map.size()];
-            **array = new K[N * super::_mult];
+            **array = Workspace::get<K>(N * super::_mult);
             for(unsigned short i = 0; i < N; ++i) {
                 array[i]  = *array + i * Subdomain<K>::_map.size();
                 *array[i] = **array + i * super::_mult;
@@ -259,6 +389,24 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             static_cast<Solver<K>*>(super::_pinv)->solve(super::_structure);
             A<'N', 0>(_primal, out ? out : in);
         }
+        /* Function: apply(n)
+         *
+         *  Applies the global FETI operator to multiple vectors.
+         *
+         * Parameters:
+         *    in             - Input vectors, see <Feti::allocateBlock>.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        inline void apply(K* const* const in, K* const* const out, const unsigned short& mu) const {
+            K* const work = Workspace::get<K>(mu * Subdomain<K>::_a->_n);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                std::fill_n(work + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                A<'T', 0>(work + nu * Subdomain<K>::_a->_n + super::_bi->_m, in + nu * Subdomain<K>::_map.size());
+            }
+            static_cast<Solver<K>*>(super::_pinv)->solve(work, mu);
+            A<'N', 0>(work + super::_bi->_m, out, mu, Subdomain<K>::_a->_n);
+            Workspace::release(work);
+        }
         /* Function: applyLocalPreconditioner(n)
          *
          *  Applies the local preconditioner to multiple right-hand sides.
@@ -270,7 +418,7 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *    u              - Input vectors.
          *    n              - Number of input vectors. */
         template<FetiPrcndtnr q = P>
-        inline void applyLocalPreconditioner(K*& u, unsigned short n) const {
+        inline void applyLocalPreconditioner(K* const u, unsigned short n) const {
             switch(q) {
                 case FetiPrcndtnr::DIRICHLET:   super::applyLocalSchurComplement(u, n); break;
                 case FetiPrcndtnr::LUMPED:      super::applyLocalLumpedMatrix(u, n); break;
@@ -309,6 +457,22 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             applyLocalPreconditioner<q>(_primal);
             A<'N', 1>(_primal, out ? out : in);
         }
+        /* Function: precond(n)
+         *
+         *  Applies the global preconditioner to multiple vectors.
+         *
+         * Parameters:
+         *    in             - Input vectors, see <Feti::allocateBlock>.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        template<FetiPrcndtnr q = P>
+        inline void precond(K* const* const in, K* const* const out, const unsigned short& mu) const {
+            K* const work = Workspace::get<K>(mu * Subdomain<K>::_dof);
+            A<'T', 1>(work, in, mu, Subdomain<K>::_dof);
+            applyLocalPreconditioner<q>(work, mu);
+            A<'N', 1>(work, out, mu, Subdomain<K>::_dof);
+            Workspace::release(work);
+        }
         /* Function: project
          *
          *  Projects into the coarse space.
@@ -362,6 +526,63 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
             else if(!excluded && out)
                 std::copy(*in, *in + super::_mult, *out);
         }
+        /* Function: project(n)
+         *
+         *  Projects multiple vectors into the coarse space with a single coarse solve.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    trans          - 'T' if the transposed projection should be applied, 'N' otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors, see <Feti::allocateBlock>.
+         *    out            - Output vectors, nullptr if the projection is performed in-place.
+         *    mu             - Number of vectors. */
+        template<bool excluded, char trans>
+        inline void project(K* const* const in, K* const* const out, const unsigned short& mu) const {
+            static_assert(trans == 'T' || trans == 'N', "Unsupported value for argument 'trans'");
+            if(super::_co) {
+                K* const uc = Workspace::get<K>(mu * super::_co->getSizeRHS());
+                if(!excluded) {
+                    K** dual;
+                    allocateBlock(dual, mu);
+                    if(trans == 'T')
+                        precond(in, dual, mu);
+                    if(super::_ev) {
+                        const int m = mu;
+                        const int ld = super::_schur ? Subdomain<K>::_dof : Subdomain<K>::_a->_n;
+                        const K* const ev = super::_schur ? *super::_ev : *super::_ev + super::_bi->_m;
+                        K* const primal = Workspace::get<K>(mu * Subdomain<K>::_dof);
+                        A<'T', 0>(primal, trans == 'T' ? dual : in, mu, Subdomain<K>::_dof);
+                        Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), primal, &(Subdomain<K>::_dof), ev, &ld, &(Wrapper<K>::d__0), uc, &m);
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), ev, &ld, uc, &m, &(Wrapper<K>::d__0), primal, &(Subdomain<K>::_dof));
+                        A<'N', 0>(primal, dual, mu, Subdomain<K>::_dof);
+                        Workspace::release(primal);
+                    }
+                    else {
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                        std::fill_n(*dual, mu * super::_mult, K());
+                    }
+                    if(trans == 'N')
+                        precond(dual, dual, mu);
+                    if(out)
+                        for(int i = 0; i < mu * super::_mult; ++i)
+                            (*out)[i] = (*in)[i] - (*dual)[i];
+                    else {
+                        const int size = mu * super::_mult;
+                        Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), *dual, &i__1, *in, &i__1);
+                    }
+                    Workspace::release(*dual);
+                    delete [] dual;
+                }
+                else
+                    super::_co->template callSolver<excluded>(uc, 0, mu);
+                Workspace::release(uc);
+            }
+            else if(!excluded && out)
+                std::copy_n(*in, mu * super::_mult, *out);
+        }
         /* Function: buildTwo
          *
          *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>.
@@ -436,6 +657,71 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
         }
         template<bool>
         inline void computeSolution(K* const, const K* const) const { }
+        /* Function: computeSolution(n)
+         *
+         *  Computes multiple solutions after convergence of the block Projected Conjugate Gradient, with a single coarse solve.
+         *
+         * Template Parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    x              - Solution vectors.
+         *    l              - Last iterates of the Lagrange multipliers, see <Feti::allocateBlock>.
+         *    mu             - Number of vectors. */
+        template<bool excluded>
+        inline void computeSolution(K* const x, K* const* const l, const unsigned short& mu) const {
+            K* const uc = super::_co ? Workspace::get<K>(mu * super::_co->getSizeRHS()) : nullptr;
+            if(!excluded) {
+                const int size = mu * Subdomain<K>::_a->_n;
+                K* const work = Workspace::get<K>(size);
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    std::fill_n(work + nu * Subdomain<K>::_a->_n, super::_bi->_m, K());
+                    A<'T', 0>(work + nu * Subdomain<K>::_a->_n + super::_bi->_m, l + nu * Subdomain<K>::_map.size());
+                }
+                static_cast<Solver<K>*>(super::_pinv)->solve(work, mu);
+                Wrapper<K>::axpy(&size, &(Wrapper<K>::d__2), work, &i__1, x, &i__1);
+                if(super::_co) {
+                    K** dual;
+                    allocateBlock(dual, mu);
+                    A<'N', 0>(x + super::_bi->_m, dual, mu, Subdomain<K>::_a->_n);
+                    precond(dual, dual, mu);
+                    if(!super::_ev)
+                        super::_co->template callSolver<excluded>(uc, 0, mu);
+                    else {
+                        const int m = mu;
+                        K* const primal = work;
+                        A<'T', 0>(primal, dual, mu, Subdomain<K>::_dof);
+                        if(super::_schur) {
+                            Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), primal, &(Subdomain<K>::_dof), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), uc, &m);
+                            super::_co->template callSolver<excluded>(uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), uc, &m, &(Wrapper<K>::d__0), primal, &(Subdomain<K>::_dof));
+                            K* const interior = Workspace::get<K>(size);
+                            Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &m, &(super::_bi->_m), &(Wrapper<K>::d__2), false, super::_bi->_a, super::_bi->_ia, super::_bi->_ja, primal, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), interior, &(Subdomain<K>::_a->_n));
+                            super::_s.solve(interior, mu);
+                            for(unsigned short nu = 0; nu < mu; ++nu) {
+                                Wrapper<K>::axpy(&(super::_bi->_m), &(Wrapper<K>::d__2), interior + nu * Subdomain<K>::_a->_n, &i__1, x + nu * Subdomain<K>::_a->_n, &i__1);
+                                Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), primal + nu * Subdomain<K>::_dof, &i__1, x + nu * Subdomain<K>::_a->_n + super::_bi->_m, &i__1);
+                            }
+                            Workspace::release(interior);
+                        }
+                        else {
+                            Wrapper<K>::gemm(&transb, &transa, &m, super::_co->getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), primal, &(Subdomain<K>::_dof), *super::_ev + super::_bi->_m, &(Subdomain<K>::_a->_n), &(Wrapper<K>::d__0), uc, &m);
+                            super::_co->template callSolver<excluded>(uc, 0, mu);
+                            Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_a->_n), &m, super::_co->getAddrLocal(), &(Wrapper<K>::d__2), *super::_ev, &(Subdomain<K>::_a->_n), uc, &m, &(Wrapper<K>::d__1), x, &(Subdomain<K>::_a->_n));
+                        }
+                    }
+                    Workspace::release(*dual);
+                    delete [] dual;
+                }
+                Workspace::release(work);
+            }
+            else if(super::_co)
+                super::_co->template callSolver<excluded>(uc, 0, mu);
+            if(uc)
+                Workspace::release(uc);
+        }
+        template<bool>
+        inline void computeSolution(K* const, const K* const, const unsigned short&) const { }
         /* Function: computeDot
          *
          *  Computes the dot product of two Lagrange multipliers.
@@ -445,14 +731,13 @@ class Feti : public Schur<Solver, CoarseOperator<CoarseSolver, S, K>, K> {
          *
          * Parameters:
          *    a              - Left-hand side.
-         *    b              - Right-hand side. */
+         *    b              - Right-hand side.
+         *    mu             - Number of Lagrange multipliers in a and b, see <Feti::allocateBlock> (optional). */
         template<bool excluded>
-        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm) const {
-            if(!excluded)
-                *val = Wrapper<K>::dot(&(super::_mult), *a, &i__1, *b, &i__1) / 2.0;
-            else
-                *val = 0.0;
-            MPI_Allreduce(MPI_IN_PLACE, val, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+        inline void computeDot(typename Wrapper<K>::ul_type* const val, const K* const* const a, const K* const* const b, const MPI_Comm& comm, const unsigned short& mu = 1) const {
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                val[nu] = excluded ? 0.0 : Wrapper<K>::dot(&(super::_mult), *a + nu * super::_mult, &i__1, *b + nu * super::_mult, &i__1) / 2.0;
+            MPI_Allreduce(MPI_IN_PLACE, val, mu, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
         }
         /* Function: getScaling
          *  Returns a constant pointer to <Feti::m>. */
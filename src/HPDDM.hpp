@@ -38,7 +38,18 @@
  *    HPDDM_BDD           - BDD methods enabled.
  *    HPDDM_QR            - If not set to zero, pseudo-inverses of Schur complements are computed using dense QR decompositions (with pivoting if set to one, without pivoting otherwise).
  *    HPDDM_ICOLLECTIVE   - If possible, use nonblocking MPI collective operations.
- *    HPDDM_GMV           - For overlapping Schwarz methods, this can be used to reduce the volume of communication for computing global matrix-vector products. */
+ *    HPDDM_GMV           - For overlapping Schwarz methods, this can be used to reduce the volume of communication for computing global matrix-vector products.
+ *    HPDDM_NEIGHBORHOOD  - If possible, exchange values with neighboring subdomains using MPI neighborhood collective operations on a distributed graph topology.
+ *    HPDDM_SHARED        - If possible, exchange values with neighboring subdomains on the same node through MPI shared memory windows instead of point-to-point communications.
+ *    HPDDM_MIXED         - For overlapping Schwarz methods, if set to one (resp. two), the values exchanged after local solves in <Schwarz::apply> are sent in single precision (resp. as 16-bit truncated floating-point numbers). Additive coarse corrections are then exchanged separately in full precision.
+ *    HPDDM_SPLITMV       - For overlapping Schwarz methods, if not set to zero, the rows of nonsymmetric local matrices on the interface with neighboring subdomains are computed first so that communications overlap the computation of interior rows.
+ *    HPDDM_SSTEP         - Number of Krylov vectors generated per outer step of the s-step GMRES.
+ *    HPDDM_REPLACEMENT   - Number of iterations between two residual replacements of the pipelined BiCGStab.
+ *    HPDDM_LOWSYNC       - If not set to zero, the classical GMRES uses a reorthogonalized classical Gram--Schmidt procedure with lagged normalization requiring a single global reduction per iteration, instead of the default procedure requiring two.
+ *    HPDDM_ALIGN         - Alignment in bytes of the arrays cached by <Workspace>.
+ *    HPDDM_CACHE         - Maximum size in bytes of the unused arrays kept by <Workspace> for each thread.
+ *    HPDDM_RUN           - Minimal average length of the runs of consecutive unknowns on the interface with a neighboring subdomain for values to be packed and unpacked by runs instead of by indices.
+ *    HPDDM_LARGE         - If not set to zero, ranks and numbers of processes as well as iteration counts are stored as 32-bit unsigned integers instead of 16-bit ones, which is required on more than 65535 processes. */
 #define HPDDM_VERSION         000003
 #define HPDDM_EPS             1.0e-12
 #define HPDDM_PEN             1.0e+30
@@ -63,6 +74,39 @@
 #define HPDDM_QR              1
 #define HPDDM_ICOLLECTIVE     0
 #define HPDDM_GMV             0
+#ifndef HPDDM_NEIGHBORHOOD
+#define HPDDM_NEIGHBORHOOD    0
+#endif
+#ifndef HPDDM_SHARED
+#define HPDDM_SHARED          0
+#endif
+#ifndef HPDDM_MIXED
+#define HPDDM_MIXED           0
+#endif
+#ifndef HPDDM_SPLITMV
+#define HPDDM_SPLITMV         0
+#endif
+#ifndef HPDDM_SSTEP
+#define HPDDM_SSTEP           4
+#endif
+#ifndef HPDDM_REPLACEMENT
+#define HPDDM_REPLACEMENT     50
+#endif
+#ifndef HPDDM_LOWSYNC
+#define HPDDM_LOWSYNC         0
+#endif
+#ifndef HPDDM_ALIGN
+#define HPDDM_ALIGN           64
+#endif
+#ifndef HPDDM_CACHE
+#define HPDDM_CACHE           1073741824
+#endif
+#ifndef HPDDM_RUN
+#define HPDDM_RUN             4
+#endif
+#ifndef HPDDM_LARGE
+#define HPDDM_LARGE           0
+#endif
 
 #include <mpi.h>
 #if HPDDM_ICOLLECTIVE
@@ -72,6 +116,20 @@
 #define HPDDM_ICOLLECTIVE     0
 #endif
 #endif // HPDDM_ICOLLECTIVE
+#if HPDDM_NEIGHBORHOOD
+#if !((OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000)
+#pragma message("You cannot use MPI neighborhood collective operations with that MPI implementation")
+#undef HPDDM_NEIGHBORHOOD
+#define HPDDM_NEIGHBORHOOD    0
+#endif
+#endif // HPDDM_NEIGHBORHOOD
+#if HPDDM_SHARED
+#if !((OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000) || HPDDM_NEIGHBORHOOD
+#pragma message("You cannot use MPI shared memory windows with that MPI implementation or with neighborhood collective operations")
+#undef HPDDM_SHARED
+#define HPDDM_SHARED          0
+#endif
+#endif // HPDDM_SHARED
 
 #include <iomanip>
 #include <complex>
@@ -126,7 +184,9 @@ void    HPDDM_F77(C ## symm)(const char*, const char*, const int*, const int*,
                              const T*, T*, const int*);                                                      \
 void    HPDDM_F77(C ## gemm)(const char*, const char*, const int*, const int*, const int*,                   \
                              const T*, const T*, const int*, const T*, const int*,                           \
-                             const T*, T*, const int*);
+                             const T*, T*, const int*);                                                      \
+void    HPDDM_F77(C ## trsm)(const char*, const char*, const char*, const char*, const int*, const int*,      \
+                             const T*, const T*, const int*, T*, const int*);
 #if !defined(__APPLE__) && !HPDDM_MKL
 #define HPDDM_GENERATE_EXTERN_DOTC(C, T, U) U  _Complex HPDDM_F77(C ## dotc)(const int*, const T*, const int*, const T*, const int*);
 #else
@@ -136,6 +196,10 @@ void    HPDDM_F77(C ## gemm)(const char*, const char*, const int*, const int*, c
 U  HPDDM_F77(B ## nrm2)(const int*, const U*, const int*);                                                   \
 U  HPDDM_F77(B ## C ## nrm2)(const int*, const T*, const int*);                                              \
 U  HPDDM_F77(B ## dot)(const int*, const U*, const int*, const U*, const int*);                              \
+void HPDDM_F77(B ## geev)(const char*, const char*, const int*, U*, const int*, U*, U*, U*, const int*,      \
+                          U*, const int*, U*, const int*, int*);                                             \
+void HPDDM_F77(C ## geev)(const char*, const char*, const int*, T*, const int*, T*, T*, const int*,          \
+                          T*, const int*, T*, const int*, U*, int*);                                         \
 HPDDM_GENERATE_EXTERN_DOTC(C, T, U)
 #define HPDDM_GENERATE_EXTERN_MKL(C, T)                                                                      \
 void cblas_ ## C ## gthr(const int, const T*, T*, const int*);                                               \
@@ -187,8 +251,15 @@ static constexpr char transb =  'T';
 static constexpr int i__0    =    0;
 static constexpr int i__1    =    1;
 
-typedef std::pair<unsigned short, std::vector<int>>  pairNeighbor; // MPI_Comm_size < MAX_UNSIGNED_SHORT
-typedef std::vector<pairNeighbor>                  vectorNeighbor;
+/* Typedef: index_type
+ *  Unsigned integer type of ranks and numbers of processes and of iteration counts, see <HPDDM_LARGE>. */
+#if HPDDM_LARGE
+typedef unsigned int                                 index_type;
+#else
+typedef unsigned short                               index_type; // MPI_Comm_size < MAX_UNSIGNED_SHORT
+#endif
+typedef std::pair<index_type, std::vector<int>>    pairNeighbor;
+typedef std::vector<pairNeighbor>                vectorNeighbor;
 #ifdef __GNUG__
 std::string demangle(const char* name) {
     int status;
@@ -246,6 +317,8 @@ static inline T sto(std::string s, typename std::enable_if<std::is_same<T, doubl
 #pragma GCC diagnostic pop
 #endif
 #endif
+#include "workspace.hpp"
+#include "history.hpp"
 #include "matrix.hpp"
 #include "dmatrix.hpp"
 
@@ -294,6 +367,8 @@ static inline T sto(std::string s, typename std::enable_if<std::is_same<T, doubl
 #include "schwarz.hpp"
 template<class K = double, char S = 'S'>
 using HpSchwarz = HPDDM::Schwarz<SUBDOMAIN, COARSEOPERATOR, S, K>;
+template<class K = double, class T = float, char S = 'S'>
+using HpMixedSchwarz = HPDDM::MixedPrecision<SUBDOMAIN, COARSEOPERATOR, S, K, T>;
 #endif
 #if HPDDM_FETI
 #include "FETI.hpp"
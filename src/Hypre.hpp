@@ -197,6 +197,22 @@ class Hypre : public DMatrix {
             loc = hypre_ParVectorLocalVector(reinterpret_cast<hypre_ParVector*>(hypre_IJVectorObject(reinterpret_cast<hypre_IJVector*>(_x))));
             std::copy(loc->data, loc->data + _local, rhs);
         }
+        /* Function: solve
+         *
+         *  Solves the system in-place for multiple right-hand sides. The iterative solvers of Hypre only handle a single right-hand side, so the right-hand sides are solved for one after the other.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides.
+         *    ld             - Leading dimension of rhs. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n, const int& ld) {
+            for(unsigned short nu = 0; nu < n; ++nu)
+                solve<D>(rhs + nu * ld);
+        }
         /* Function: initialize
          *
          *  Initializes <Hypre::strategy>, <DMatrix::rank>, and <DMatrix::distribution>.
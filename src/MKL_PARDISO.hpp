@@ -177,6 +177,38 @@ class MklPardiso : public DMatrix {
             K ddum;
             CLUSTER_SPARSE_SOLVER(_pt, const_cast<int*>(&i__1), const_cast<int*>(&i__1), &_mtype, &phase, &(DMatrix::_n), _C, _I, _J, const_cast<int*>(&i__1), const_cast<int*>(&i__1), _iparm, const_cast<int*>(&i__0), rhs, _w, const_cast<int*>(&_comm), &error);
         }
+        /* Function: solve
+         *
+         *  Solves the system in-place for multiple right-hand sides.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides.
+         *    ld             - Leading dimension of rhs. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n, const int& ld) {
+            int error;
+            int phase = 33;
+            int nrhs = n;
+            const int local = _iparm[41] - _iparm[40] + 1;
+            K* b = rhs;
+            if(ld != local) {
+                b = new K[n * local];
+                for(unsigned short nu = 0; nu < n; ++nu)
+                    std::copy_n(rhs + nu * ld, local, b + nu * local);
+            }
+            K* const x = new K[n * local];
+            CLUSTER_SPARSE_SOLVER(_pt, const_cast<int*>(&i__1), const_cast<int*>(&i__1), &_mtype, &phase, &(DMatrix::_n), _C, _I, _J, const_cast<int*>(&i__1), &nrhs, _iparm, const_cast<int*>(&i__0), b, x, const_cast<int*>(&_comm), &error);
+            delete [] x;
+            if(b != rhs) {
+                for(unsigned short nu = 0; nu < n; ++nu)
+                    std::copy_n(b + nu * local, local, rhs + nu * ld);
+                delete [] b;
+            }
+        }
         /* Function: initialize
          *
          *  Initializes <MKL Pardiso::comm>,  <DMatrix::rank>, and <DMatrix::distribution>.
@@ -195,6 +195,47 @@ class Mumps : public DMatrix {
                 MUMPS_STRUC_C<K>::mumps_c(_id);
             }
         }
+        /* Function: solve
+         *
+         *  Solves the system in-place for multiple right-hand sides.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides.
+         *    ld             - Leading dimension of rhs. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n, const int& ld) {
+            _id->nrhs = n;
+            _id->lrhs = ld;
+            _id->rhs = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(rhs);
+            _id->job = 3;
+            if(D == DMatrix::DISTRIBUTED_SOL) {
+                _id->icntl[20] = 1;
+                int info = _id->info[22];
+                int* isol_loc = new int[info];
+                K* sol_loc = new K[n * info];
+                _id->sol_loc = reinterpret_cast<typename MUMPS_STRUC_C<K>::mumps_type*>(sol_loc);
+                _id->lsol_loc = info;
+                _id->isol_loc = isol_loc;
+                MUMPS_STRUC_C<K>::mumps_c(_id);
+                for(unsigned short nu = 0; nu < n; ++nu) {
+                    if(!DMatrix::_mapOwn && !DMatrix::_mapRecv)
+                        DMatrix::initializeMap<0>(info, _id->isol_loc, sol_loc, rhs);
+                    else
+                        DMatrix::redistribute<0>(sol_loc + nu * info, rhs + nu * ld);
+                }
+                delete [] sol_loc;
+                delete [] isol_loc;
+            }
+            else {
+                _id->icntl[20] = 0;
+                MUMPS_STRUC_C<K>::mumps_c(_id);
+            }
+            _id->nrhs = 1;
+        }
         /* Function: initialize
          *
          *  Initializes <Mumps::strategy>, <DMatrix::rank>, and <DMatrix::distribution>.
@@ -237,6 +237,37 @@ class Pastix : public DMatrix {
             DMatrix::redistribute<2>(rhs, rhs2, fuse);
             delete [] rhs2;
         }
+        /* Function: solve
+         *
+         *  Solves the system in-place for multiple right-hand sides.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides.
+         *    ld             - Leading dimension of rhs. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n, const int& ld) {
+            K* rhs2 = new K[n * _ncol2];
+            for(unsigned short nu = 0; nu < n; ++nu) {
+                if(!DMatrix::_mapOwn && !DMatrix::_mapRecv)
+                    DMatrix::initializeMap<1>(_ncol2, _loc2glob2, rhs2, rhs);
+                else
+                    DMatrix::redistribute<1>(rhs2 + nu * _ncol2, rhs + nu * ld);
+            }
+
+            _iparm[IPARM_START_TASK] = API_TASK_SOLVE;
+            _iparm[IPARM_END_TASK]   = API_TASK_SOLVE;
+            pstx<K>::dist(&_data, DMatrix::_communicator,
+                          _ncol2, _colptr2, _rows2, _values2, _loc2glob2,
+                          NULL, NULL, rhs2, n, _iparm, _dparm);
+
+            for(unsigned short nu = 0; nu < n; ++nu)
+                DMatrix::redistribute<2>(rhs + nu * ld, rhs2 + nu * _ncol2);
+            delete [] rhs2;
+        }
         /* Function: initialize
          *
          *  Initializes <DMatrix::rank> and <DMatrix::distribution>.
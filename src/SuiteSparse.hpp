@@ -233,6 +233,38 @@ class SuiteSparse : public DMatrix {
                 stsprs<K>::umfpack_wsolve(UMFPACK_Aat, NULL, NULL, NULL, _tmp, rhs, _numeric, _control, NULL, _pattern, _W);
             std::copy(_tmp, _tmp + DMatrix::_n, rhs);
         }
+        /* Function: solve
+         *
+         *  Solves the system in-place for multiple right-hand sides. UMFPACK has no multiple right-hand side solve, so the right-hand sides are then solved for one after the other.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    n              - Number of right-hand sides.
+         *    ld             - Leading dimension of rhs. */
+        template<DMatrix::Distribution D>
+        inline void solve(K* rhs, const unsigned short& n, const int& ld) {
+            if(_c) {
+                K* const x = new K[n * DMatrix::_n];
+                _b->ncol = n;
+                _b->d = ld;
+                _b->nzmax = n * ld;
+                _b->x = rhs;
+                _x->ncol = n;
+                _x->nzmax = n * _x->nrow;
+                _x->x = x;
+                cholmod_solve2(CHOLMOD_A, _L, _b, NULL, &_x, NULL, &_Y, &_E, _c);
+                _b->d = _b->nrow;
+                for(unsigned short nu = 0; nu < n; ++nu)
+                    std::copy_n(x + nu * DMatrix::_n, DMatrix::_n, rhs + nu * ld);
+                delete [] x;
+            }
+            else
+                for(unsigned short nu = 0; nu < n; ++nu)
+                    solve<D>(rhs + nu * ld);
+        }
         template<class Container>
         inline void initialize(Container& parm) {
             if(DMatrix::_communicator != MPI_COMM_NULL)
@@ -25,6 +25,7 @@
 #define _COARSE_OPERATOR_
 
 #include <cmath>
+#include <unordered_map>
 
 #if defined(DMKL_PARDISO) || defined(DPASTIX) || defined(DSUITESPARSE) || defined(DHYPRE)
 #define HPDDM_CSR_CO
@@ -68,6 +69,9 @@ class CoarseOperator : public Solver<K> {
          *  Local size of right-hand sides and solution vectors. */
         unsigned int              _sizeRHS;
         bool                       _offset;
+        /* Variable: types
+         *  Contiguous MPI datatypes used by <Coarse operator::callSolver> for multiple right-hand sides, created on first use and keyed on the number of right-hand sides. */
+        std::unordered_map<unsigned short, MPI_Datatype> _types;
         /* Function: constructionCommunicator
          *
          *  Builds both <Coarse operator::scatterComm> and <DMatrix::communicator>.
@@ -75,7 +79,7 @@ class CoarseOperator : public Solver<K> {
          * Template Parameter:
          *    T              - Matrix distribution topology. */
         template<char T, bool exclude>
-        inline void constructionCommunicator(const MPI_Comm&, unsigned short&);
+        inline void constructionCommunicator(const MPI_Comm&, index_type&);
         /* Function: constructionCollective
          *
          *  Builds the buffers <DMatrix::gatherCounts>, <DMatrix::displs>, <DMatrix::gatherSplitCounts>, and <DMatrix::displsSplit> for all collective communications involving coarse corrections.
@@ -85,7 +89,7 @@ class CoarseOperator : public Solver<K> {
          *    D              - <DMatrix::Distribution> of right-hand sides and solution vectors.
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise. */
         template<bool U, typename Solver<K>::Distribution D, bool excluded>
-        inline void constructionCollective(const unsigned short* = nullptr, unsigned short p = 0, const unsigned short* = nullptr);
+        inline void constructionCollective(const index_type* = nullptr, index_type p = 0, const index_type* = nullptr);
         /* Function: constructionMap
          *
          *  Builds the maps <DMatrix::ldistribution> and <DMatrix::idistribution> necessary for sending and receiving distributed right-hand sides or solution vectors.
@@ -95,7 +99,7 @@ class CoarseOperator : public Solver<K> {
          *    U              - True if the distribution of the coarse operator is uniform, false otherwise.
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise. */
         template<char T, bool U, bool excluded>
-        inline void constructionMap(unsigned short, const unsigned short* = nullptr);
+        inline void constructionMap(index_type, const index_type* = nullptr);
         /* Function: constructionMatrix
          *
          *  Builds and factorizes the coarse operator.
@@ -106,7 +110,7 @@ class CoarseOperator : public Solver<K> {
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *    Operator       - Operator used in the definition of the Galerkin matrix. */
         template<char T, unsigned short U, unsigned short excluded, class Operator>
-        inline std::pair<MPI_Request, const K*>* constructionMatrix(Operator&, unsigned short);
+        inline std::pair<MPI_Request, const K*>* constructionMatrix(Operator&, index_type);
         /* Function: constructionCommunicatorCollective
          *
          *  Builds both communicators <Coarse operator::gatherComm> and <DMatrix::scatterComm> needed for coarse corrections.
@@ -114,8 +118,8 @@ class CoarseOperator : public Solver<K> {
          * Template Parameter:
          *    countMasters   - True if the master processes must be taken into consideration, false otherwise. */
         template<bool countMasters>
-        inline void constructionCommunicatorCollective(const unsigned short* const pt, unsigned short size, MPI_Comm& in, MPI_Comm* const out = nullptr) {
-            unsigned short sizeComm = std::count_if(pt, pt + size, [](const unsigned short& nu) { return nu != 0; });
+        inline void constructionCommunicatorCollective(const index_type* const pt, index_type size, MPI_Comm& in, MPI_Comm* const out = nullptr) {
+            index_type sizeComm = std::count_if(pt, pt + size, [](const index_type& nu) { return nu != 0; });
             if(sizeComm != size && in != MPI_COMM_NULL) {
                 MPI_Group oldComm, newComm;
                 MPI_Comm_group(in, &oldComm);
@@ -123,10 +127,10 @@ class CoarseOperator : public Solver<K> {
                     ++sizeComm;
                 int* array = new int[sizeComm];
                 array[0] = 0;
-                for(unsigned short i = 1, j = 1, k = 0; j < sizeComm; ++i) {
+                for(index_type i = 1, j = 1, k = 0; j < sizeComm; ++i) {
                     if(pt[i] != 0)
                         array[j++] = i - k;
-                    else if(countMasters && Solver<K>::_ldistribution[k + 1] == i)
+                    else if(countMasters && Solver<K>::_ldistribution[k + 1] == static_cast<int>(i))
                         ++k;
                 }
                 MPI_Group_incl(oldComm, sizeComm, array, &newComm);
@@ -148,6 +152,33 @@ class CoarseOperator : public Solver<K> {
             else if(out)
                 MPI_Comm_dup(in, out);
         }
+        /* Function: multiSolve
+         *
+         *  Solves a coarse system with multiple right-hand sides stored one unknown after the other, see <Coarse operator::callSolver>. Right-hand sides are transposed so that they are all passed to the solver in a single call.
+         *
+         * Template Parameter:
+         *    D              - Distribution of right-hand sides and solution vectors.
+         *
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    offset         - Offset of the first unknown solved for.
+         *    mu             - Number of right-hand sides. */
+        template<DMatrix::Distribution D>
+        inline void multiSolve(K* const rhs, const int& offset, const unsigned short& mu) {
+            if(mu == 1)
+                Solver<K>::template solve<D>(rhs + offset);
+            else {
+                K* const work = Workspace::get<K>(mu * _sizeRHS);
+                for(unsigned int i = 0; i < _sizeRHS; ++i)
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        work[nu * _sizeRHS + i] = rhs[i * mu + nu];
+                Solver<K>::template solve<D>(work + offset, mu, _sizeRHS);
+                for(unsigned int i = 0; i < _sizeRHS; ++i)
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        rhs[i * mu + nu] = work[nu * _sizeRHS + i];
+                Workspace::release(work);
+            }
+        }
     public:
         CoarseOperator() : _gatherComm(MPI_COMM_NULL), _scatterComm(MPI_COMM_NULL), _rankWorld(), _sizeWorld(), _sizeSplit(), _local(), _sizeRHS(), _offset(false) {
             static_assert(S == 'S' || S == 'G', "Unknown symmetry");
@@ -158,6 +189,8 @@ class CoarseOperator : public Solver<K> {
                 MPI_Comm_free(&_gatherComm);
             if(_scatterComm != MPI_COMM_NULL)
                 MPI_Comm_free(&_scatterComm);
+            for(std::pair<const unsigned short, MPI_Datatype>& type : _types)
+                MPI_Type_free(&type.second);
         }
         /* Function: construction
          *  Wrapper function to call all needed subroutines. */
@@ -167,10 +200,12 @@ class CoarseOperator : public Solver<K> {
          *
          *  Solves a coarse system.
          *
-         * Parameter:
-         *    rhs            - Input right-hand side, solution vector is stored in-place. */
+         * Parameters:
+         *    rhs            - Input right-hand sides, solution vectors are stored in-place.
+         *    fuse           - Number of fused reductions (optional).
+         *    mu             - Number of right-hand sides (optional), stored one unknown after the other so that each process sends a single message, incompatible with fused reductions. */
         template<bool = false>
-        inline void callSolver(K* const, const int& = 0);
+        inline void callSolver(K* const, const int& = 0, const unsigned short& = 1);
 #if HPDDM_ICOLLECTIVE
         template<bool = false>
         inline void IcallSolver(K* const, MPI_Request*, const int& = 0);
@@ -33,15 +33,15 @@
 namespace HPDDM {
 template<template<class> class Solver, char S, class K>
 template<char T, bool exclude>
-inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Comm& comm, unsigned short& p) {
+inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Comm& comm, index_type& p) {
     MPI_Comm_size(comm, &_sizeWorld);
     MPI_Comm_rank(comm, &_rankWorld);
-    if(p > _sizeWorld / 2 && _sizeWorld > 1) {
+    if(static_cast<int>(p) > _sizeWorld / 2 && _sizeWorld > 1) {
         p = _sizeWorld / 2;
         if(_rankWorld == 0)
             std::cout << "WARNING -- the number of master processes was set to a value greater than MPI_Comm_size, the value has been reset to " << p << std::endl;
     }
-    p = std::max(p, static_cast<unsigned short>(1));
+    p = std::max(p, static_cast<index_type>(1));
     if(p == 1) {
         MPI_Comm_dup(comm, &_gatherComm);
         MPI_Comm_dup(comm, &_scatterComm);
@@ -59,7 +59,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
         unsigned int tmp;
         Solver<K>::_ldistribution = new int[p];
         if(T == 0) {
-            if(_rankWorld < (p - 1) * (_sizeWorld / p))
+            if(_rankWorld < static_cast<int>((p - 1) * (_sizeWorld / p)))
                 tmp = _sizeWorld / p;
             else
                 tmp = _sizeWorld - (p - 1) * (_sizeWorld / p);
@@ -70,16 +70,16 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
             else
                 offset = (_sizeWorld / p) * (_rankWorld / (_sizeWorld / p));
             std::iota(ps, ps + tmp, offset);
-            for(unsigned short i = 0; i < p; ++i)
+            for(index_type i = 0; i < p; ++i)
                 Solver<K>::_ldistribution[i] = i * (_sizeWorld / p);
         }
         else if(T == 1) {
-            if(_rankWorld == p - 1 || _rankWorld > p - 1 + (p - 1) * ((_sizeWorld - p) / p))
+            if(_rankWorld == static_cast<int>(p - 1) || _rankWorld > static_cast<int>(p - 1 + (p - 1) * ((_sizeWorld - p) / p)))
                 tmp = _sizeWorld - (p - 1) * (_sizeWorld / p);
             else
                 tmp = _sizeWorld / p;
             ps = new int[tmp];
-            if(_rankWorld < p)
+            if(_rankWorld < static_cast<int>(p))
                 ps[0] = _rankWorld;
             else {
                 if(tmp == _sizeWorld / p)
@@ -95,10 +95,10 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
             // Here, it is assumed that all subdomains have the same number of coarse degrees of freedom as the rank 0 ! (only true when the distribution is uniform)
             float area = _sizeWorld *_sizeWorld / (2.0 * p);
             *Solver<K>::_ldistribution = 0;
-            for(unsigned short i = 1; i < p; ++i)
+            for(index_type i = 1; i < p; ++i)
                 Solver<K>::_ldistribution[i] = static_cast<int>(_sizeWorld - std::sqrt(std::max(_sizeWorld * _sizeWorld - 2 * _sizeWorld * Solver<K>::_ldistribution[i - 1] - 2 * area + Solver<K>::_ldistribution[i - 1] * Solver<K>::_ldistribution[i - 1], 1.0f)) + 0.5);
             int* idx = std::upper_bound(Solver<K>::_ldistribution, Solver<K>::_ldistribution + p, _rankWorld);
-            unsigned short i = idx - Solver<K>::_ldistribution;
+            index_type i = idx - Solver<K>::_ldistribution;
             tmp = (i == p) ? _sizeWorld - Solver<K>::_ldistribution[i - 1] : Solver<K>::_ldistribution[i] - Solver<K>::_ldistribution[i - 1];
             ps = new int[tmp];
             for(unsigned int j = 0; j < tmp; ++j)
@@ -128,7 +128,7 @@ inline void CoarseOperator<Solver, S, K>::constructionCommunicator(const MPI_Com
 
 template<template<class> class Solver, char S, class K>
 template<bool U, typename Solver<K>::Distribution D, bool excluded>
-inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned short* info, unsigned short p, const unsigned short* infoSplit) {
+inline void CoarseOperator<Solver, S, K>::constructionCollective(const index_type* info, index_type p, const index_type* infoSplit) {
     if(!U) {
         if(excluded)
             _sizeWorld -= p;
@@ -159,11 +159,11 @@ inline void CoarseOperator<Solver, S, K>::constructionCollective(const unsigned
 
 template<template<class> class Solver, char S, class K>
 template<char T, bool U, bool excluded>
-inline void CoarseOperator<Solver, S, K>::constructionMap(unsigned short p, const unsigned short* info) {
+inline void CoarseOperator<Solver, S, K>::constructionMap(index_type p, const index_type* info) {
     if(T == 0) {
         if(!U) {
             unsigned int accumulate = 0;
-            for(unsigned short i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
+            for(index_type i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
                 Solver<K>::_ldistribution[i] = std::accumulate(info + i * (_sizeWorld / p), info + (i + 1) * (_sizeWorld / p), 0);
             Solver<K>::_ldistribution[p - 1] = Solver<K>::_n - accumulate;
         }
@@ -200,7 +200,7 @@ inline void CoarseOperator<Solver, S, K>::constructionMap(unsigned short p, cons
         std::iota(Solver<K>::_idistribution + j, Solver<K>::_idistribution + Solver<K>::_n, j);
         if(!U) {
             unsigned int accumulate = 0;
-            for(unsigned short i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
+            for(index_type i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
                 Solver<K>::_ldistribution[i] = std::accumulate(info + p + i * (_sizeWorld / p - 1), info + p + (i + 1) * (_sizeWorld / p - 1), info[i]);
             Solver<K>::_ldistribution[p - 1] = Solver<K>::_n - accumulate;
         }
@@ -212,12 +212,12 @@ inline void CoarseOperator<Solver, S, K>::constructionMap(unsigned short p, cons
     else if(T == 2) {
         if(!U) {
             unsigned int accumulate = 0;
-            for(unsigned short i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
+            for(index_type i = 0; i < p - 1; accumulate += Solver<K>::_ldistribution[i++])
                 Solver<K>::_ldistribution[i] = std::accumulate(info + Solver<K>::_ldistribution[i], info + Solver<K>::_ldistribution[i + 1], 0);
             Solver<K>::_ldistribution[p - 1] = Solver<K>::_n - accumulate;
         }
         else {
-            for(unsigned short i = 0; i < p - 1; ++i)
+            for(index_type i = 0; i < p - 1; ++i)
                 Solver<K>::_ldistribution[i] = (Solver<K>::_ldistribution[i + 1] - Solver<K>::_ldistribution[i] - excluded) * _local;
             Solver<K>::_ldistribution[p - 1] = Solver<K>::_n - (Solver<K>::_ldistribution[p - 1] - (excluded ? p - 1 : 0)) * _local;
         }
@@ -237,13 +237,15 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 std::cout << "WARNING -- only one master process supported by the " << demangle(typeid(Solver<K>).name()) << " interface, forcing P to one" << std::endl;
             parm[P] = 1;
         }
+    index_type p = parm[P];
     switch(parm[TOPOLOGY]) {
 #ifndef HPDDM_CONTIGUOUS
-        case  1: constructionCommunicator<1, (excluded > 0)>(comm, parm[P]); break;
+        case  1: constructionCommunicator<1, (excluded > 0)>(comm, p); break;
 #endif
-        case  2: constructionCommunicator<2, (excluded > 0)>(comm, parm[P]); break;
-        default: constructionCommunicator<0, (excluded > 0)>(comm, parm[P]); break;
+        case  2: constructionCommunicator<2, (excluded > 0)>(comm, p); break;
+        default: constructionCommunicator<0, (excluded > 0)>(comm, p); break;
     }
+    parm[P] = p;
     if(excluded > 0 && Solver<K>::_communicator != MPI_COMM_NULL) {
         int result;
         MPI_Comm_compare(v._p.getCommunicator(), Solver<K>::_communicator, &result);
@@ -257,26 +259,26 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     Solver<K>::initialize(parm);
     switch(parm[TOPOLOGY]) {
 #ifndef HPDDM_CONTIGUOUS
-        case  1: return constructionMatrix<1, U, excluded>(v, parm[P]);
+        case  1: return constructionMatrix<1, U, excluded>(v, p);
 #endif
-        case  2: return constructionMatrix<2, U, excluded>(v, parm[P]);
-        default: return constructionMatrix<0, U, excluded>(v, parm[P]);
+        case  2: return constructionMatrix<2, U, excluded>(v, p);
+        default: return constructionMatrix<0, U, excluded>(v, p);
     }
 }
 
 template<template<class> class Solver, char S, class K>
 template<char T, unsigned short U, unsigned short excluded, class Operator>
-inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::constructionMatrix(Operator& v, unsigned short p) {
-    unsigned short* const info = new unsigned short[(U != 1 ? 3 : 1) + v.getConnectivity()];
-    const std::vector<unsigned short>& sparsity = v.getPattern();
+inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::constructionMatrix(Operator& v, index_type p) {
+    index_type* const info = new index_type[(U != 1 ? 3 : 1) + v.getConnectivity()];
+    const std::vector<index_type>& sparsity = v.getPattern();
     info[0] = sparsity.size(); // number of intersections
     int rank;
     MPI_Comm_rank(v._p.getCommunicator(), &rank);
-    const unsigned short first = (S == 'S' ? std::distance(sparsity.cbegin(), std::upper_bound(sparsity.cbegin(), sparsity.cend(), rank)) : 0);
+    const index_type first = (S == 'S' ? std::distance(sparsity.cbegin(), std::upper_bound(sparsity.cbegin(), sparsity.cend(), rank)) : 0);
     int rankSplit;
     MPI_Comm_size(_scatterComm, &_sizeSplit);
     MPI_Comm_rank(_scatterComm, &rankSplit);
-    unsigned short* infoNeighbor;
+    index_type* infoNeighbor;
 
     K*     sendMaster;
     unsigned int size;
@@ -285,43 +287,43 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     K*   C;
 
     if(U != 1) {
-        infoNeighbor = new unsigned short[info[0]];
+        infoNeighbor = new index_type[info[0]];
         info[1] = (excluded == 2 ? 0 : _local); // number of eigenvalues
         std::vector<MPI_Request> sendInfo;
         sendInfo.reserve(info[0]);
         MPI_Request rq;
         if(excluded == 0) {
             if(T != 2)
-                for(unsigned short i = 0; i < info[0]; ++i) {
+                for(index_type i = 0; i < info[0]; ++i) {
                     if(!(T == 1 && sparsity[i] < p) &&
                        !(T == 0 && (sparsity[i] % (_sizeWorld / p) == 0) && sparsity[i] < p * (_sizeWorld / p))) {
-                        MPI_Isend(info + 1, 1, MPI_UNSIGNED_SHORT, sparsity[i], 1, v._p.getCommunicator(), &rq);
+                        MPI_Isend(info + 1, 1, Wrapper<index_type>::mpi_type(), sparsity[i], 1, v._p.getCommunicator(), &rq);
                         sendInfo.emplace_back(rq);
                     }
                 }
             else
-                for(unsigned short i = 0; i < info[0]; ++i) {
+                for(index_type i = 0; i < info[0]; ++i) {
                     if(!std::binary_search(Solver<K>::_ldistribution, Solver<K>::_ldistribution + p, sparsity[i])) {
-                        MPI_Isend(info + 1, 1, MPI_UNSIGNED_SHORT, sparsity[i], 1, v._p.getCommunicator(), &rq);
+                        MPI_Isend(info + 1, 1, Wrapper<index_type>::mpi_type(), sparsity[i], 1, v._p.getCommunicator(), &rq);
                         sendInfo.emplace_back(rq);
                     }
                 }
         }
         else if(excluded < 2) {
-            for(unsigned short i = 0; i < info[0]; ++i) {
-                MPI_Isend(info + 1, 1, MPI_UNSIGNED_SHORT, sparsity[i], 1, v._p.getCommunicator(), &rq);
+            for(index_type i = 0; i < info[0]; ++i) {
+                MPI_Isend(info + 1, 1, Wrapper<index_type>::mpi_type(), sparsity[i], 1, v._p.getCommunicator(), &rq);
                 sendInfo.emplace_back(rq);
             }
         }
         if(rankSplit != 0) {
             MPI_Request* recvInfo = new MPI_Request[info[0]];
-            for(unsigned short i = 0; i < info[0]; ++i)
-                MPI_Irecv(infoNeighbor + i, 1, MPI_UNSIGNED_SHORT, sparsity[i], 1, v._p.getCommunicator(), recvInfo + i);
+            for(index_type i = 0; i < info[0]; ++i)
+                MPI_Irecv(infoNeighbor + i, 1, Wrapper<index_type>::mpi_type(), sparsity[i], 1, v._p.getCommunicator(), recvInfo + i);
             unsigned int tmp = (S != 'S' ? _local : 0);
-            for(unsigned short i = 0; i < info[0]; ++i) {
+            for(index_type i = 0; i < info[0]; ++i) {
                 int index;
                 MPI_Waitany(info[0], recvInfo, &index, MPI_STATUS_IGNORE);
-                if(!(S == 'S' && sparsity[index] < rank))
+                if(!(S == 'S' && static_cast<int>(sparsity[index]) < rank))
                     tmp += infoNeighbor[index];
             }
             delete [] recvInfo;
@@ -338,8 +340,8 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                     std::copy_n(sparsity.cbegin() + first, info[0], info + (U != 1 ? 3 : 1));
                 else {
                     if(T == 0 || T == 2) {
-                        for(unsigned short i = 0; i < info[0]; ++i) {
-                            unsigned short j = 0;
+                        for(index_type i = 0; i < info[0]; ++i) {
+                            index_type j = 0;
                             info[(U != 1 ? 3 : 1) + i] = sparsity[i + first] + 1;
                             while(j < p - 1 && info[(U != 1 ? 3 : 1) + i] >= (T == 0 ? (_sizeWorld / p) * (j + 1) : Solver<K>::_ldistribution[j + 1])) {
                                 ++info[(U != 1 ? 3 : 1) + i];
@@ -348,7 +350,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                         }
                     }
                     else if(T == 1) {
-                        for(unsigned short i = 0; i < info[0]; ++i)
+                        for(index_type i = 0; i < info[0]; ++i)
                             info[(U != 1 ? 3 : 1) + i] = p + sparsity[i + first];
                     }
                 }
@@ -369,9 +371,9 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             std::copy_n(sparsity.cbegin() + first, info[0], info + (U != 1 ? 3 : 1));
         }
     }
-    unsigned short** infoSplit;
+    index_type**     infoSplit;
     unsigned int*    offsetIdx;
-    unsigned short*  infoWorld;
+    index_type*      infoWorld;
 
     unsigned int offset;
 #ifdef HPDDM_CSR_CO
@@ -382,17 +384,17 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 #endif
 
     if(rankSplit != 0)
-        MPI_Gather(info, (U != 1 ? 3 : 1) + v.getConnectivity(), MPI_UNSIGNED_SHORT, NULL, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+        MPI_Gather(info, (U != 1 ? 3 : 1) + v.getConnectivity(), Wrapper<index_type>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
     else {
         size = 0;
-        infoSplit = new unsigned short*[_sizeSplit];
-        *infoSplit = new unsigned short[_sizeSplit * ((U != 1 ? 3 : 1) + v.getConnectivity()) + (U != 1) * _sizeWorld];
-        MPI_Gather(info, (U != 1 ? 3 : 1) + v.getConnectivity(), MPI_UNSIGNED_SHORT, *infoSplit, (U != 1 ? 3 : 1) + v.getConnectivity(), MPI_UNSIGNED_SHORT, 0, _scatterComm);
+        infoSplit = new index_type*[_sizeSplit];
+        *infoSplit = new index_type[_sizeSplit * ((U != 1 ? 3 : 1) + v.getConnectivity()) + (U != 1) * _sizeWorld];
+        MPI_Gather(info, (U != 1 ? 3 : 1) + v.getConnectivity(), Wrapper<index_type>::mpi_type(), *infoSplit, (U != 1 ? 3 : 1) + v.getConnectivity(), Wrapper<index_type>::mpi_type(), 0, _scatterComm);
         for(unsigned int i = 1; i < _sizeSplit; ++i)
             infoSplit[i] = *infoSplit + i * ((U != 1 ? 3 : 1) + v.getConnectivity());
         if(S == 'S' && Operator::_pattern == 's')
             **infoSplit -= first;
-        offsetIdx = new unsigned int[std::max(_sizeSplit - 1, 2 * p)];
+        offsetIdx = new unsigned int[std::max(_sizeSplit - 1, static_cast<int>(2 * p))];
         if(U != 1) {
             infoWorld = *infoSplit + _sizeSplit * (3 + v.getConnectivity());
             int* recvcounts = reinterpret_cast<int*>(offsetIdx);
@@ -412,10 +414,10 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 #ifdef HPDDM_CSR_CO
             nrow = std::accumulate(infoWorld + displs[Solver<K>::_rank], infoWorld + displs[Solver<K>::_rank] + _sizeSplit, 0);
 #endif
-            MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, infoWorld, recvcounts, displs, MPI_UNSIGNED_SHORT, Solver<K>::_communicator);
+            MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, infoWorld, recvcounts, displs, Wrapper<index_type>::mpi_type(), Solver<K>::_communicator);
             if(T == 1) {
                 unsigned int i = (p - 1) * (_sizeWorld / p);
-                for(unsigned short k = p - 1, j = 1; k-- > 0; i -= _sizeWorld / p, ++j) {
+                for(index_type k = p - 1, j = 1; k-- > 0; i -= _sizeWorld / p, ++j) {
                     recvcounts[k] = infoWorld[i];
                     std::copy_backward(infoWorld + k * (_sizeWorld / p), infoWorld + (k + 1) * (_sizeWorld / p), infoWorld + (k + 1) * (_sizeWorld / p) + j);
                 }
@@ -425,13 +427,13 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             Solver<K>::_n = std::accumulate(infoWorld + _rankWorld, infoWorld + _sizeWorld, offset);
             if(Solver<K>::_numbering == 'F')
                 ++offset;
-            unsigned short tmp = 0;
-            for(unsigned short i = 0; i < info[0]; ++i) {
+            index_type tmp = 0;
+            for(index_type i = 0; i < info[0]; ++i) {
                 infoNeighbor[i] = infoWorld[sparsity[i]];
                 if(!(S == 'S' && i < first))
                     tmp += infoNeighbor[i];
             }
-            for(unsigned short k = 1; k < _sizeSplit; size += infoSplit[k++][2])
+            for(int k = 1; k < _sizeSplit; size += infoSplit[k++][2])
                 offsetIdx[k - 1] = size;
             if(excluded < 2)
                 size += _local * tmp + (S == 'S' ? _local * (_local + 1) / 2 : _local * _local);
@@ -445,13 +447,13 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             nrow = (_sizeSplit - (excluded == 2)) * _local;
 #endif
             if(S == 'S') {
-                for(unsigned short i = 1; i < _sizeSplit; size += infoSplit[i++][0])
+                for(int i = 1; i < _sizeSplit; size += infoSplit[i++][0])
                     offsetIdx[i - 1] = size * _local * _local + (i - 1) * _local * (_local + 1) / 2;
                 info[0] -= first;
                 size = (size + info[0]) * _local * _local + _local * (_local + 1) / 2 * (_sizeSplit - (excluded == 2));
             }
             else {
-                for(unsigned short i = 1; i < _sizeSplit; size += infoSplit[i++][0])
+                for(int i = 1; i < _sizeSplit; size += infoSplit[i++][0])
                     offsetIdx[i - 1] = (i - 1 + size) * _local * _local;
                 size = (size + info[0] + _sizeSplit - (excluded == 2)) * _local * _local;
             }
@@ -490,23 +492,23 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         rqSend.reserve(S != 'S' ? info[0] : first);
         sendNeighbor = new K*[(S != 'S' ? info[0] : first) + (U == 1 || _local ? info[0] : 0)];
         unsigned int accumulate = 0;
-        for(unsigned short i = 0; i < (S != 'S' ? info[0] : first); ++i)
+        for(index_type i = 0; i < (S != 'S' ? info[0] : first); ++i)
             if(U == 1 || infoNeighbor[i])
                 accumulate += _local * M[i].second.size();
         if(U == 1 || _local)
-            for(unsigned short i = 0; i < info[0]; ++i)
+            for(index_type i = 0; i < info[0]; ++i)
                 accumulate += (U == 1 ? _local : infoNeighbor[i + first]) * M[i + first].second.size();
         if(excluded < 2)
             *sendNeighbor = new K[accumulate];
         accumulate = 0;
-        for(unsigned short i = 0; i < (S != 'S' ? info[0] : first); ++i) {
+        for(index_type i = 0; i < (S != 'S' ? info[0] : first); ++i) {
             sendNeighbor[i] = *sendNeighbor + accumulate;
             if(U == 1 || infoNeighbor[i])
                 accumulate += _local * M[i].second.size();
         }
         recvNeighbor = (U == 1 || _local ? sendNeighbor + (S != 'S' ? info[0] : first) : nullptr);
         if(U == 1 || _local) {
-            for(unsigned short i = 0; i < info[0]; ++i) {
+            for(index_type i = 0; i < info[0]; ++i) {
                 recvNeighbor[i] = *sendNeighbor + accumulate;
                 MPI_Irecv(recvNeighbor[i], (U == 1 ? _local : infoNeighbor[i + first]) * M[i + first].second.size(), Wrapper<K>::mpi_type(), M[i + first].first, 2, v._p.getCommunicator(), rqRecv + i);
                 accumulate += (U == 1 ? _local : infoNeighbor[i + first]) * M[i + first].second.size();
@@ -529,11 +531,11 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
     if(Operator::_pattern == 's' && excluded < 2) {
         const K* const* const& EV = v._p.getVectors();
         const int n = v._p.getDof();
-        v.initialize(n * (U == 1 || info[0] == 0 ? _local : std::max(static_cast<unsigned short>(_local), *std::max_element(infoNeighbor + first, infoNeighbor + sparsity.size()))), work, S != 'S' ? info[0] : first);
+        v.initialize(n * (U == 1 || info[0] == 0 ? _local : std::max(static_cast<index_type>(_local), *std::max_element(infoNeighbor + first, infoNeighbor + sparsity.size()))), work, S != 'S' ? info[0] : first);
         v.template applyToNeighbor<S, U == 1>(sendNeighbor, work, rqSend, infoNeighbor);
         if(S != 'S') {
-            unsigned short before = 0;
-            for(unsigned short j = 0; j < info[0] && sparsity[j] < rank; ++j)
+            index_type before = 0;
+            for(index_type j = 0; j < info[0] && static_cast<int>(sparsity[j]) < rank; ++j)
                 before += (U == 1 ? _local : infoNeighbor[j]);
             K* const pt = (rankSplit != 0 ? sendMaster + before : C + before);
             Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &_local, &_local, &n, &(Wrapper<K>::d__1), work, &n, *EV, &n, &(Wrapper<K>::d__0), pt, &coefficients);
@@ -584,15 +586,15 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             if(Operator::_pattern == 's') {
                 unsigned int* offsetArray = new unsigned int[info[0]];
                 if(S != 'S')
-                    offsetArray[0] = M[0].first > rank ? _local : 0;
+                    offsetArray[0] = static_cast<int>(M[0].first) > rank ? _local : 0;
                 else if(info[0] > 0)
                     offsetArray[0] = _local;
-                for(unsigned short k = 1; k < info[0]; ++k) {
+                for(index_type k = 1; k < info[0]; ++k) {
                     offsetArray[k] = offsetArray[k - 1] + (U == 1 ? _local : infoNeighbor[k - 1 + first]);
-                    if(S != 'S' && sparsity[k - 1] < rank && sparsity[k] > rank)
+                    if(S != 'S' && static_cast<int>(sparsity[k - 1]) < rank && static_cast<int>(sparsity[k]) > rank)
                         offsetArray[k] += _local;
                 }
-                for(unsigned short k = 0; k < info[0]; ++k) {
+                for(index_type k = 0; k < info[0]; ++k) {
                     int index;
                     MPI_Waitany(info[0], rqRecv, &index, MPI_STATUS_IGNORE);
                     v.template assembleForMaster<S, U == 1>(sendMaster + offsetArray[index], recvNeighbor[index], coefficients + (S == 'S' ? _local - 1 : 0), index + first, work, infoNeighbor + first + index);
@@ -600,7 +602,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 delete [] offsetArray;
             }
             else {
-                for(unsigned short k = 0; k < M.size(); ++k) {
+                for(index_type k = 0; k < M.size(); ++k) {
                     int index;
                     MPI_Waitany(M.size(), rqRecv, &index, MPI_STATUS_IGNORE);
                     v.template assembleForMaster<S, U == 1>(sendMaster, recvNeighbor[index], coefficients, index, work, infoNeighbor);
@@ -635,7 +637,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         delete [] work;
     }
     else {
-        unsigned short rankRelative = (T == 0 || T == 2) ? _rankWorld : p + _rankWorld * ((_sizeWorld / p) - 1) - 1;
+        index_type rankRelative = (T == 0 || T == 2) ? _rankWorld : p + _rankWorld * ((_sizeWorld / p) - 1) - 1;
         unsigned int* offsetPosition;
         unsigned int idx;
         if(excluded < 2) {
@@ -648,7 +650,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         int* counts = new int[2 * _sizeSplit];
         counts[0] = 0;
         counts[_sizeSplit] = (U == 1 ? (S == 'S' ? _local * infoSplit[0][0] * _local + _local * (_local + 1) / 2 : (_local * infoSplit[0][0] + _local) * _local) : infoSplit[0][2]);
-        for(unsigned short k = 1; k < _sizeSplit; ++k) {
+        for(int k = 1; k < _sizeSplit; ++k) {
             counts[k] = offsetIdx[k - 1];
             counts[_sizeSplit + k] = (U == 1 ? (counts[_sizeSplit + k - 1] + (S == 'S' ? (_local * infoSplit[k][0] * _local + _local * (_local + 1) / 2) : ((_local * infoSplit[k][0] + _local) * _local))) : infoSplit[k][2]);
         }
@@ -657,7 +659,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 #endif
         if(U != 1) {
 #if !HPDDM_ICOLLECTIVE
-            for(unsigned short k = 1; k < _sizeSplit; ++k) {
+            for(int k = 1; k < _sizeSplit; ++k) {
                 if(infoSplit[k][2])
                     MPI_Irecv(C + offsetIdx[k - 1], infoSplit[k][2], Wrapper<K>::mpi_type(), k, 3, _scatterComm, rqRecv + idx + k - 1);
                 else
@@ -675,7 +677,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         }
 #if !HPDDM_ICOLLECTIVE
         else {
-            for(unsigned short k = 1; k < _sizeSplit; ++k)
+            for(int k = 1; k < _sizeSplit; ++k)
                 MPI_Irecv(C + offsetIdx[k - 1], S == 'S' ? _local * infoSplit[k][0] * _local + _local * (_local + 1) / 2 : (_local * infoSplit[k][0] + _local) * _local, Wrapper<K>::mpi_type(), k, 3, _scatterComm, rqRecv + idx + k - 1);
         }
 #endif
@@ -686,7 +688,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 unsigned int offsetSlave;
                 if(U != 1)
                     offsetSlave = std::accumulate(infoWorld, infoWorld + infoSplit[k][3], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
-                unsigned short i = 0;
+                index_type i = 0;
                 int* colIdx = J + offsetIdx[k - 1];
                 if(S != 'S')
                     while(i < infoSplit[k][0] && infoSplit[k][(U != 1 ? 3 : 1) + i] < rankRelative + k - (U == 1 && excluded == 2 ? (T == 1 ? p : 1 + rank) : 0)) {
@@ -750,7 +752,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         delete [] offsetIdx;
         if(excluded < 2) {
 #ifdef HPDDM_CSR_CO
-            for(unsigned short k = 0; k < _local; ++k) {
+            for(int k = 0; k < _local; ++k) {
                 I[k + 1] = coefficients + (S == 'S' ? _local - k : 0);
 #if defined(HPDDM_LOC2GLOB) && !defined(HPDDM_CONTIGUOUS)
                 loc2glob[k] = offset + k;
@@ -766,7 +768,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             *offsetArray = new unsigned int[info[0] * ((Operator::_pattern == 's') + (U != 1))];
             if(Operator::_pattern == 's') {
                 if(S != 'S') {
-                    offsetArray[0][0] = sparsity[0] > _rankWorld ? _local : 0;
+                    offsetArray[0][0] = static_cast<int>(sparsity[0]) > _rankWorld ? _local : 0;
                     if(U != 1)
                         offsetArray[0][1] = std::accumulate(infoWorld, infoWorld + sparsity[0], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
                 }
@@ -777,7 +779,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                             offsetArray[0][1] = std::accumulate(infoWorld, infoWorld + sparsity[first], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
                     }
                 }
-                for(unsigned short k = 1; k < info[0]; ++k) {
+                for(index_type k = 1; k < info[0]; ++k) {
                     if(U != 1) {
                         offsetArray[k] = *offsetArray + 2 * k;
                         offsetArray[k][1] = std::accumulate(infoWorld + sparsity[first + k - 1], infoWorld + sparsity[first + k], offsetArray[k - 1][1]);
@@ -787,7 +789,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                         offsetArray[k] = *offsetArray + k;
                         offsetArray[k][0] = offsetArray[k - 1][0] + _local;
                     }
-                    if((S != 'S') && sparsity[k - 1] < _rankWorld && sparsity[k] > _rankWorld)
+                    if((S != 'S') && static_cast<int>(sparsity[k - 1]) < _rankWorld && static_cast<int>(sparsity[k]) > _rankWorld)
                         offsetArray[k][0] += _local;
                 }
             }
@@ -797,7 +799,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                         offsetArray[0][0] = std::accumulate(infoWorld, infoWorld + sparsity[0], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
                     else if(info[0] > 0)
                         offsetArray[0][0] = std::accumulate(infoWorld, infoWorld + sparsity[first], static_cast<unsigned int>(Solver<K>::_numbering == 'F'));
-                    for(unsigned short k = 1; k < info[0]; ++k) {
+                    for(index_type k = 1; k < info[0]; ++k) {
                         offsetArray[k] = *offsetArray + k;
                         offsetArray[k][0] = std::accumulate(infoWorld + sparsity[first + k - 1], infoWorld + sparsity[first + k], offsetArray[k - 1][0]);
                     }
@@ -896,18 +898,18 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
         }
     }
     else {
-        unsigned short* pt;
-        unsigned short size;
+        index_type* pt;
+        index_type size;
         switch(Solver<K>::_distribution) {
             case DMatrix::NON_DISTRIBUTED:
                 if(rankSplit != 0)
-                    infoWorld = new unsigned short[_sizeWorld];
+                    infoWorld = new index_type[_sizeWorld];
                 pt = infoWorld;
                 size = _sizeWorld;
                 break;
             case DMatrix::DISTRIBUTED_SOL:
                 size = _sizeWorld + _sizeSplit;
-                pt = new unsigned short[size];
+                pt = new index_type[size];
                 if(rankSplit == 0) {
                     std::copy(infoWorld, infoWorld + _sizeWorld, pt);
                     for(unsigned int i = 0; i < _sizeSplit; ++i)
@@ -915,19 +917,19 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 }
                 break;
             case DMatrix::DISTRIBUTED_SOL_AND_RHS:
-                unsigned short* infoMaster;
+                index_type* infoMaster;
                 if(rankSplit == 0) {
                     infoMaster = infoSplit[0];
                     for(unsigned int i = 0; i < _sizeSplit; ++i)
                         infoMaster[i] = infoSplit[i][1];
                 }
                 else
-                    infoMaster = new unsigned short[_sizeSplit];
+                    infoMaster = new index_type[_sizeSplit];
                 pt = infoMaster;
                 size = _sizeSplit;
                 break;
         }
-        MPI_Bcast(pt, size, MPI_UNSIGNED_SHORT, 0, _scatterComm);
+        MPI_Bcast(pt, size, Wrapper<index_type>::mpi_type(), 0, _scatterComm);
         if(Solver<K>::_distribution == DMatrix::NON_DISTRIBUTED || Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL_AND_RHS) {
             if(Solver<K>::_distribution == DMatrix::NON_DISTRIBUTED)
                 constructionCommunicatorCollective<(excluded > 0)>(pt, size, _gatherComm, &_scatterComm);
@@ -951,7 +953,7 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
                 else if(U == 2) {
                     Solver<K>::_gatherCounts = new int[1];
                     if(_local == 0) {
-                        _local = *Solver<K>::_gatherCounts = *std::find_if(infoWorld, infoWorld + _sizeWorld, [](const unsigned short& nu) { return nu != 0; });
+                        _local = *Solver<K>::_gatherCounts = *std::find_if(infoWorld, infoWorld + _sizeWorld, [](const index_type& nu) { return nu != 0; });
                         _sizeRHS += _local;
                     }
                     else
@@ -981,14 +983,14 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
             else if(U == 2) {
                 Solver<K>::_gatherCounts = new int[1];
                 if(_local == 0) {
-                    _local = *Solver<K>::_gatherCounts = *std::find_if(infoWorld, infoWorld + _sizeWorld, [](const unsigned short& nu) { return nu != 0; });
+                    _local = *Solver<K>::_gatherCounts = *std::find_if(infoWorld, infoWorld + _sizeWorld, [](const index_type& nu) { return nu != 0; });
                     _sizeRHS += _local;
                 }
                 else
                     *Solver<K>::_gatherCounts = _local;
             }
             else {
-                unsigned short* infoMaster = infoSplit[0];
+                index_type* infoMaster = infoSplit[0];
                 for(unsigned int i = 0; i < _sizeSplit; ++i)
                     infoMaster[i] = infoSplit[i][1];
                 constructionCollective<false, DMatrix::DISTRIBUTED_SOL, excluded == 2>(infoWorld, p - 1, infoMaster);
@@ -1008,58 +1010,70 @@ inline std::pair<MPI_Request, const K*>* CoarseOperator<Solver, S, K>::construct
 
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
-inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fuse) {
+inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fuse, const unsigned short& mu) {
+    History::coarse();
+    MPI_Datatype type = Wrapper<K>::mpi_type();
+    if(mu > 1) {
+        std::unordered_map<unsigned short, MPI_Datatype>::const_iterator it = _types.find(mu);
+        if(it == _types.cend()) {
+            MPI_Type_contiguous(mu, Wrapper<K>::mpi_type(), &type);
+            MPI_Type_commit(&type);
+            _types.emplace(mu, type);
+        }
+        else
+            type = it->second;
+    }
     if(_scatterComm != MPI_COMM_NULL) {
         if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL) {
             if(Solver<K>::_displs) {
-                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs);
-                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    multiSolve<DMatrix::DISTRIBUTED_SOL>(rhs, 0, mu);
+                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else
-                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
             else {
-                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
-                    MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    multiSolve<DMatrix::DISTRIBUTED_SOL>(rhs, (_offset || excluded ? *Solver<K>::_gatherCounts : 0), mu);
+                    MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else
-                    MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
         }
         else if(Solver<K>::_distribution == DMatrix::NON_DISTRIBUTED) {
             if(Solver<K>::_displs) {
-                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL)
-                    Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs);
-                if(_rankWorld == 0)                   MPI_Scatterv(rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                else if(_gatherComm != MPI_COMM_NULL) MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _gatherComm);
+                    multiSolve<DMatrix::NON_DISTRIBUTED>(rhs, 0, mu);
+                if(_rankWorld == 0)                   MPI_Scatterv(rhs, Solver<K>::_gatherCounts, Solver<K>::_displs, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                else if(_gatherComm != MPI_COMM_NULL) MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _gatherComm);
             }
             else {
-                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                else                                  MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                if(_rankWorld == 0)                   MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                else                                  MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
                 if(Solver<K>::_communicator != MPI_COMM_NULL)
-                    Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs + (_offset || excluded ? _local : 0));
-                if(_rankWorld == 0)                   MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
-                else                                  MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    multiSolve<DMatrix::NON_DISTRIBUTED>(rhs, (_offset || excluded ? _local : 0), mu);
+                if(_rankWorld == 0)                   MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                else                                  MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
             }
         }
         else if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL_AND_RHS) {
             if(Solver<K>::_displs) {
                 if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                    MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                    Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs);
-                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                    MPI_Gatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, 0, _gatherComm);
+                    multiSolve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, 0, mu);
+                    MPI_Scatterv(rhs, Solver<K>::_gatherSplitCounts, Solver<K>::_displsSplit, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                 }
                 else {
-                    MPI_Gatherv(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                    MPI_Gatherv(rhs, _local, type, NULL, 0, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                    MPI_Scatterv(NULL, 0, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                 }
             }
             else {
@@ -1068,7 +1082,7 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
                     _local += fuse;
                     if(Solver<K>::_communicator != MPI_COMM_NULL) {
                         *Solver<K>::_gatherCounts += fuse;
-                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
+                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
                         unsigned int end = _sizeSplit * *Solver<K>::_gatherCounts - fuse;
                         K* pt = rhs + *Solver<K>::_gatherCounts - fuse;
                         for(unsigned int i = 1; i < _sizeSplit; ++i)
@@ -1077,25 +1091,25 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
                         MPI_Allreduce(MPI_IN_PLACE, rhs + end, fuse, Wrapper<K>::mpi_type(), MPI_SUM, Solver<K>::_communicator);
                         for(unsigned int i = _sizeSplit - 1; i > 0; --i)
                             std::copy_n(rhs + end, fuse, pt + (i - 1) * *Solver<K>::_gatherCounts);
-                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                         *Solver<K>::_gatherCounts -= fuse;
                     }
                     else {
-                        MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                        MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                     }
                     _local -= fuse;
                 }
                 else {
 #endif // DPASTIX || DMKL_PARDISO
                     if(Solver<K>::_communicator != MPI_COMM_NULL) {
-                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), 0, _gatherComm);
-                        Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs + (_offset || excluded ? *Solver<K>::_gatherCounts : 0));
-                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, Wrapper<K>::mpi_type(), MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
+                        MPI_Gather(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, rhs, *Solver<K>::_gatherCounts, type, 0, _gatherComm);
+                        multiSolve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, (_offset || excluded ? *Solver<K>::_gatherCounts : 0), mu);
+                        MPI_Scatter(rhs, *Solver<K>::_gatherCounts, type, MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, 0, _scatterComm);
                     }
                     else {
-                        MPI_Gather(rhs, _local, Wrapper<K>::mpi_type(), NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
-                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, Wrapper<K>::mpi_type(), 0, _scatterComm);
+                        MPI_Gather(rhs, _local, type, NULL, 0, MPI_DATATYPE_NULL, 0, _gatherComm);
+                        MPI_Scatter(NULL, 0, MPI_DATATYPE_NULL, rhs, _local, type, 0, _scatterComm);
                     }
 #if defined(DPASTIX) || defined(DMKL_PARDISO)
                 }
@@ -1105,9 +1119,9 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
     }
     else if(Solver<K>::_communicator != MPI_COMM_NULL) {
         switch(Solver<K>::_distribution) {
-            case DMatrix::NON_DISTRIBUTED:         Solver<K>::template solve<DMatrix::NON_DISTRIBUTED>(rhs); break;
-            case DMatrix::DISTRIBUTED_SOL:         Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL>(rhs); break;
-            case DMatrix::DISTRIBUTED_SOL_AND_RHS: Solver<K>::template solve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs); break;
+            case DMatrix::NON_DISTRIBUTED:         multiSolve<DMatrix::NON_DISTRIBUTED>(rhs, 0, mu); break;
+            case DMatrix::DISTRIBUTED_SOL:         multiSolve<DMatrix::DISTRIBUTED_SOL>(rhs, 0, mu); break;
+            case DMatrix::DISTRIBUTED_SOL_AND_RHS: multiSolve<DMatrix::DISTRIBUTED_SOL_AND_RHS>(rhs, 0, mu); break;
         }
     }
 }
@@ -1116,6 +1130,7 @@ inline void CoarseOperator<Solver, S, K>::callSolver(K* const rhs, const int& fu
 template<template<class> class Solver, char S, class K>
 template<bool excluded>
 inline void CoarseOperator<Solver, S, K>::IcallSolver(K* const rhs, MPI_Request* rq, const int& fuse) {
+    History::coarse();
     if(_scatterComm != MPI_COMM_NULL) {
         if(Solver<K>::_distribution == DMatrix::DISTRIBUTED_SOL) {
             if(Solver<K>::_displs) {
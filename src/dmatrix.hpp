@@ -50,16 +50,16 @@ class DMatrix {
          *    exclude        - True if the master processes have to be excluded from the original communicator.
          *    p              - Number of master processes.
          *    T              - Master processes distribution topology. */
-        static inline bool splitCommunicator(const MPI_Comm& in, MPI_Comm& out, const bool& exclude, unsigned short& p, const unsigned short& T) {
+        static inline bool splitCommunicator(const MPI_Comm& in, MPI_Comm& out, const bool& exclude, index_type& p, const unsigned short& T) {
             int size, rank;
             MPI_Comm_size(in, &size);
             MPI_Comm_rank(in, &rank);
-            if(p > size / 2 && size > 1) {
+            if(static_cast<int>(p) > size / 2 && size > 1) {
                 p = size / 2;
                 if(rank == 0)
                     std::cout << "WARNING -- the number of master processes was set to a value greater than MPI_Comm_size, the value has been reset to " << p << std::endl;
             }
-            p = std::max(p, static_cast<unsigned short>(1));
+            p = std::max(p, static_cast<index_type>(1));
             if(exclude) {
                 MPI_Group oldGroup, newGroup;
                 MPI_Comm_group(in, &oldGroup);
@@ -69,11 +69,11 @@ class DMatrix {
                 else if(T == 2) {
                     float area = size * size / (2.0 * p);
                     *pm = 0;
-                    for(unsigned short i = 1; i < p; ++i)
+                    for(index_type i = 1; i < p; ++i)
                         pm[i] = static_cast<int>(size - std::sqrt(std::max(size * size - 2 * size * pm[i - 1] - 2 * area + pm[i - 1] * pm[i - 1], 1.0f)) + 0.5);
                 }
                 else
-                    for(unsigned short i = 0; i < p; ++i)
+                    for(index_type i = 0; i < p; ++i)
                         pm[i] = i * (size / p);
                 bool excluded = std::binary_search(pm, pm + p, rank);
                 if(excluded)
@@ -97,12 +97,12 @@ class DMatrix {
         typedef std::pair<unsigned int, unsigned int>   pair_type;
         /* Typedef: map_type
          *
-         *  std::map of std::vector<T> indexed by unsigned short integers.
+         *  std::map of std::vector<T> indexed by ranks.
          *
          * Template Parameter:
          *    T              - Class. */
         template<class T>
-        using map_type = std::map<unsigned short, std::vector<T>>;
+        using map_type = std::map<index_type, std::vector<T>>;
         /* Variable: mapRecv
          *  Values that have to be received to match the distribution of the direct solver and of the user. */
         map_type<pair_type>*        _mapRecv;
@@ -162,23 +162,23 @@ class DMatrix {
             std::partial_sum(lsol_loc_glob, lsol_loc_glob + size - 1, disp_lsol_loc_glob + 1);
             MPI_Allgatherv(const_cast<int*>(isol_loc), info, MPI_INT, isol_loc_glob, lsol_loc_glob, disp_lsol_loc_glob, MPI_INT, _communicator);
             delete [] disp_lsol_loc_glob;
-            std::vector<std::pair<unsigned short, unsigned int>> mapping(_n);
-            std::vector<std::pair<unsigned short, unsigned int>> mapping_user(_n);
+            std::vector<std::pair<index_type, unsigned int>> mapping(_n);
+            std::vector<std::pair<index_type, unsigned int>> mapping_user(_n);
             _mapRecv = new map_type<pair_type>;
             _mapSend = new map_type<pair_type>;
             _mapOwn = new std::vector<pair_type>;
             unsigned int offset = 0;
-            for(unsigned short i = 0; i < size; ++i)
+            for(index_type i = 0; i < size; ++i)
                 for(unsigned int j = 0; j < lsol_loc_glob[i]; ++j)
                     mapping[isol_loc_glob[offset++] - 1] = { i, j };
             offset = 0;
             if(_idistribution) {
-                for(unsigned short i = 0; i < size; ++i)
+                for(index_type i = 0; i < size; ++i)
                     for(unsigned int j = 0; j < _ldistribution[i]; ++j)
                         mapping_user[_idistribution[offset++]] = { i, j };
             }
             else {
-                for(unsigned short i = 0; i < size; ++i)
+                for(index_type i = 0; i < size; ++i)
                     for(unsigned int j = 0; j < _ldistribution[i]; ++j)
                         mapping_user[offset++] = { i, j };
             }
@@ -187,7 +187,7 @@ class DMatrix {
             offset = std::accumulate(_ldistribution, _ldistribution + _rank, 0);
             if(!isRHS) {
                 for(unsigned int i = 0; i < info; ++i) {
-                    std::pair<unsigned short, unsigned int> tmp = mapping_user[isol_loc[i] - 1];
+                    std::pair<index_type, unsigned int> tmp = mapping_user[isol_loc[i] - 1];
                     if(tmp.first != _rank) {
                         map_send[tmp.first].emplace_back(sol_loc[i]);
                         (*_mapSend)[tmp.first].emplace_back(i, tmp.second);
@@ -195,7 +195,7 @@ class DMatrix {
                 }
                 if(_idistribution)
                     for(unsigned int i = offset; i < offset + _ldistribution[_rank]; ++i) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[_idistribution[i]];
+                        std::pair<index_type, unsigned int> tmp = mapping[_idistribution[i]];
                         if(tmp.first != _rank)
                             map_recv[tmp.first].resize(map_recv[tmp.first].size() + 1);
                         else {
@@ -205,7 +205,7 @@ class DMatrix {
                     }
                 else
                     for(unsigned int i = offset; i < offset + _ldistribution[_rank]; ++i) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[i];
+                        std::pair<index_type, unsigned int> tmp = mapping[i];
                         if(tmp.first != _rank)
                             map_recv[tmp.first].resize(map_recv[tmp.first].size() + 1);
                         else {
@@ -216,13 +216,13 @@ class DMatrix {
             }
             else {
                 for(unsigned int i = 0; i < info; ++i) {
-                    unsigned short tmp = mapping_user[isol_loc[i] - 1].first;
+                    index_type tmp = mapping_user[isol_loc[i] - 1].first;
                     if(tmp != _rank)
                         map_recv[tmp].resize(map_recv[tmp].size() + 1);
                 }
                 if(_idistribution)
                     for(unsigned int i = offset; i < offset + _ldistribution[_rank]; ++i) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[_idistribution[i]];
+                        std::pair<index_type, unsigned int> tmp = mapping[_idistribution[i]];
                         if(tmp.first != _rank) {
                             map_send[tmp.first].emplace_back(sol[i - offset]);
                             (*_mapSend)[tmp.first].emplace_back(i - offset, tmp.second);
@@ -234,7 +234,7 @@ class DMatrix {
                     }
                 else
                     for(unsigned int i = offset; i < offset + _ldistribution[_rank]; ++i) {
-                        std::pair<unsigned short, unsigned int> tmp = mapping[i];
+                        std::pair<index_type, unsigned int> tmp = mapping[i];
                         if(tmp.first != _rank) {
                             map_send[tmp.first].emplace_back(sol[i - offset]);
                             (*_mapSend)[tmp.first].emplace_back(i - offset, tmp.second);
@@ -317,7 +317,7 @@ class DMatrix {
             int gatherCount = fuse > 0 ? *_gatherCounts - fuse : 1;
             MPI_Request* rqSend = new MPI_Request[map_send_index->size() + map_recv_index->size()];
             MPI_Request* rqRecv = rqSend + map_send_index->size();
-            unsigned short i = 0;
+            index_type i = 0;
             for(map_type<pair_type>::const_reference q : *map_send_index) {
                 map_send[q.first].reserve(q.second.size());
                 for(std::vector<pair_type>::const_reference p : q.second) {
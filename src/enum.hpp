@@ -45,11 +45,35 @@ enum Parameter : char {
  *    CLASSICAL      - Classical GMRES.
  *    PIPELINED      - Pipelined GMRES.
  *    FUSED          - Fused pipelined GMRES.
+ *    SSTEP          - Communication-avoiding s-step GMRES, see <HPDDM_SSTEP>.
  *
  * See also: <Iterative method::GMRES>. */
 enum Gmres : char {
+    CLASSICAL, PIPELINED, FUSED, SSTEP
+};
+/* Enum: Cg
+ *
+ *  Defines the type of CG used.
+ *
+ *    CLASSICAL      - Classical CG.
+ *    PIPELINED      - Pipelined CG.
+ *    FUSED          - Chronopoulos--Gear projected CG, with a single global reduction per iteration overlapped with the preconditioner.
+ *
+ * See also: <Iterative method::CG> and <Iterative method::PCG>. */
+enum class Cg : char {
     CLASSICAL, PIPELINED, FUSED
 };
+/* Enum: Bicgstab
+ *
+ *  Defines the type of BiCGStab used.
+ *
+ *    CLASSICAL      - Classical BiCGStab.
+ *    PIPELINED      - Pipelined BiCGStab.
+ *
+ * See also: <Iterative method::BICGSTAB>. */
+enum class Bicgstab : char {
+    CLASSICAL, PIPELINED
+};
 /* Enum: FetiPrcndtnr
  *
  *  Defines the FETI preconditioner used in the projection.
@@ -0,0 +1,140 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): HPDDM contributors
+        Date: 2026-10-16
+
+   Copyright (C) 2026      HPDDM contributors
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _HISTORY_
+#define _HISTORY_
+
+#include <functional>
+
+namespace HPDDM {
+/* Class: History
+ *
+ *  A class that records, for each iteration of an iterative method, the residual, the time spent in the main kernels, and the number of coarse solves. A history is only filled while it is attached to the calling thread, see <History::attach>. */
+class History {
+    public:
+        /* Enum: Event
+         *
+         *    APPLY          - Applications of the preconditioner, including coarse solves.
+         *    GMV            - Global matrix-vector products.
+         *    ORTHOGONALIZATION - Local dense linear algebra of orthogonalization procedures and recurrences.
+         *    REDUCTION      - Time spent in or blocked on global reductions. */
+        enum Event : char {
+            APPLY, GMV, ORTHOGONALIZATION, REDUCTION
+        };
+        /* Struct: Iteration
+         *
+         *    residual       - Residual monitored by the iterative method, relative to its initial value.
+         *    time           - Time spent per <History::Event>.
+         *    coarse         - Number of coarse solves.
+         *    orthogonality  - Loss of orthogonality of the Krylov basis, if monitored by the iterative method, zero otherwise. */
+        struct Iteration {
+            double        residual;
+            double         time[4];
+            unsigned int    coarse;
+            double   orthogonality;
+        };
+    private:
+        /* Variable: iterations
+         *  Recorded iterations. */
+        std::vector<Iteration>                           _iterations;
+        /* Variable: current
+         *  Iteration being recorded. */
+        Iteration                                           _current;
+        /* Variable: callback
+         *  Function called after each recorded iteration (optional). */
+        std::function<void(unsigned int, const Iteration&)> _callback;
+        /* Variable: previous
+         *  History attached before this one. */
+        History*                                           _previous;
+        static History*& attached() {
+            static thread_local History* h = nullptr;
+            return h;
+        }
+    public:
+        History(const std::function<void(unsigned int, const Iteration&)>& callback = nullptr) : _current(), _callback(callback), _previous() { }
+        History(const History&) = delete;
+        ~History() {
+            if(attached() == this)
+                detach();
+        }
+        /* Function: attach
+         *  Starts recording the iterative methods called by the current thread. */
+        inline void attach() {
+            if(attached() != this) {
+                _previous = attached();
+                attached() = this;
+            }
+        }
+        /* Function: detach
+         *  Stops recording, and attaches back the previous history, if any. */
+        inline void detach() {
+            if(attached() == this) {
+                attached() = _previous;
+                _previous = nullptr;
+            }
+        }
+        /* Function: clear
+         *  Removes all recorded iterations. */
+        inline void clear() {
+            _iterations.clear();
+            _current = Iteration();
+        }
+        /* Function: getIterations
+         *  Returns a constant reference to <History::iterations>. */
+        inline const std::vector<Iteration>& getIterations() const { return _iterations; }
+        /* Function: tic
+         *  Returns the current time if a history is attached, zero otherwise. */
+        static inline double tic() {
+            return attached() ? MPI_Wtime() : 0.0;
+        }
+        /* Function: toc
+         *  Adds the time elapsed since <History::tic> to an event of the iteration being recorded. */
+        static inline void toc(const Event e, const double t) {
+            if(History* const h = attached())
+                h->_current.time[e] += MPI_Wtime() - t;
+        }
+        /* Function: coarse
+         *  Increments the number of coarse solves of the iteration being recorded. */
+        static inline void coarse() {
+            if(History* const h = attached())
+                ++h->_current.coarse;
+        }
+        /* Function: orthogonality
+         *  Sets the loss of orthogonality of the iteration being recorded. */
+        static inline void orthogonality(const double loss) {
+            if(History* const h = attached())
+                h->_current.orthogonality = loss;
+        }
+        /* Function: iteration
+         *  Ends the iteration being recorded. */
+        static inline void iteration(const double residual) {
+            if(History* const h = attached()) {
+                h->_current.residual = residual;
+                h->_iterations.emplace_back(h->_current);
+                h->_current = Iteration();
+                if(h->_callback)
+                    h->_callback(h->_iterations.size() - 1, h->_iterations.back());
+            }
+        }
+};
+} // HPDDM
+#endif // _HISTORY_
@@ -25,6 +25,39 @@
 #define _ITERATIVE_
 
 namespace HPDDM {
+class IterativeMethod;
+/* Class: Recycling
+ *
+ *  A class that stores a recycled subspace between successive calls to <Iterative method::GCRODR>.
+ *
+ * Template Parameter:
+ *    K              - Scalar type. */
+template<class K>
+class Recycling {
+    private:
+        /* Variable: U
+         *  Basis of the recycled subspace, followed by an orthonormal basis of its image by the preconditioned operator. */
+        std::vector<K>               _U;
+        /* Variable: n
+         *  Number of local rows of <Recycling::U>. */
+        int                          _n;
+        /* Variable: k
+         *  Maximum dimension of the recycled subspace. */
+        unsigned short               _k;
+        /* Variable: dim
+         *  Current dimension of the recycled subspace. */
+        unsigned short             _dim;
+        friend class IterativeMethod;
+    public:
+        Recycling(const unsigned short& k) : _n(), _k(k), _dim() { }
+        Recycling(const Recycling&) = delete;
+        /* Function: getDimension
+         *  Returns the value of <Recycling::dim>. */
+        inline unsigned short getDimension() const { return _dim; }
+        /* Function: reset
+         *  Discards the recycled subspace, e.g. if the next system to solve is unrelated to the previous ones. */
+        inline void reset() { _dim = 0; }
+};
 /* Class: Iterative method
  *  A class that implements various iterative methods. */
 class IterativeMethod {
@@ -32,15 +65,15 @@ class IterativeMethod {
         /* Function: allocate
          *  Allocates workspace arrays for <Iterative method::CG>. */
         template<class K, typename std::enable_if<std::is_same<K, typename Wrapper<K>::ul_type>::value>::type* = nullptr>
-        static inline void allocate(K*& dir, K*& p, const int& n) {
-            dir = new K[3 + 4 * n];
+        static inline void allocate(K*& dir, K*& p, const int& n, const unsigned short k = 4) {
+            dir = Workspace::get<K>(3 + k * n);
             p = dir + 3;
         }
         template<class K, typename std::enable_if<!std::is_same<K, typename Wrapper<K>::ul_type>::value>::type* = nullptr>
-        static inline void allocate(typename Wrapper<K>::ul_type*& dir, K*& p, const int& n) {
+        static inline void allocate(typename Wrapper<K>::ul_type*& dir, K*& p, const int& n, const unsigned short k = 4) {
             static_assert(std::is_same<K, std::complex<typename Wrapper<K>::ul_type>>::value, "Wrong types");
-            dir = new typename Wrapper<K>::ul_type[3];
-            p = new K[4 * n];
+            dir = Workspace::get<typename Wrapper<K>::ul_type>(3);
+            p = Workspace::get<K>(k * n);
         }
         /* Function: depenalize
          *  Divides a scalar by <HPDDM_PEN>. */
@@ -75,14 +108,204 @@ class IterativeMethod {
             }
             Wrapper<K>::gemm(&transa, &transa, &n, &i__1, &k, &(Wrapper<K>::d__1), *v, &n, s, &k, &(Wrapper<K>::d__1), x, &n);
         }
+        /* Function: conj
+         *  Conjugates a scalar. */
+        template<class K, typename std::enable_if<std::is_same<K, typename Wrapper<K>::ul_type>::value>::type* = nullptr>
+        static inline K conj(const K& a) {
+            return a;
+        }
+        template<class K, typename std::enable_if<!std::is_same<K, typename Wrapper<K>::ul_type>::value>::type* = nullptr>
+        static inline K conj(const K& a) {
+            return std::conj(a);
+        }
+        /* Function: rotate
+         *  Applies a Givens rotation to a pair of scalars. */
+        template<class K>
+        static inline void rotate(K& x, K& y, const K& cs, const K& sn) {
+            const K gamma = conj(cs) * x + conj(sn) * y;
+            y = -sn * x + cs * y;
+            x = gamma;
+        }
+        /* Function: givens
+         *  Computes the Givens rotation annihilating the second scalar of a pair, and applies it. */
+        template<class K>
+        static inline void givens(K& x, K& y, K& cs, K& sn) {
+            const typename Wrapper<K>::ul_type delta = std::sqrt(std::norm(x) + std::norm(y));
+            if(delta > 0.0) {
+                cs = x / delta;
+                sn = y / delta;
+            }
+            else {
+                cs = Wrapper<K>::d__1;
+                sn = Wrapper<K>::d__0;
+            }
+            x = delta;
+            y = K();
+        }
+        /* Function: cholesky
+         *
+         *  Computes in-place the upper triangular Cholesky factor of a Hermitian positive semi-definite matrix. Rows associated to numerically null pivots are set to zero.
+         *
+         * Template Parameter:
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    k              - Size of the matrix.
+         *    G              - Input matrix, overwritten by its Cholesky factor.
+         *    ld             - Leading dimension of G.
+         *    g              - Reference diagonal used to detect null pivots.
+         *    threshold      - Pivots lower than threshold times the reference diagonal are considered null.
+         *    piv            - Indices of the nonzero rows of the factor.
+         *
+         * Returns the numerical rank of G. */
+        template<class K>
+        static inline int cholesky(const int& k, K* const G, const int& ld, const typename Wrapper<K>::ul_type* const g, const typename Wrapper<K>::ul_type& threshold, int* const piv) {
+            int rank = 0;
+            for(int j = 0; j < k; ++j) {
+                typename Wrapper<K>::ul_type d = std::real(G[j + j * ld]);
+                for(int t = 0; t < j; ++t)
+                    d -= std::norm(G[t + j * ld]);
+                if(d > threshold * g[j]) {
+                    d = std::sqrt(d);
+                    G[j + j * ld] = d;
+                    for(int l = j + 1; l < k; ++l) {
+                        K alpha = G[j + l * ld];
+                        for(int t = 0; t < j; ++t)
+                            alpha -= conj(G[t + j * ld]) * G[t + l * ld];
+                        G[j + l * ld] = alpha / d;
+                    }
+                    piv[rank++] = j;
+                }
+                else
+                    for(int l = j; l < k; ++l)
+                        G[j + l * ld] = K();
+                std::fill(G + j * ld + j + 1, G + j * ld + k, K());
+            }
+            return rank;
+        }
+        /* Function: orthonormalize
+         *
+         *  Computes an orthonormal basis of the range of a tall and skinny matrix, given the Cholesky factor of its Gram matrix computed by <IterativeMethod::cholesky>.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    n              - Number of local rows.
+         *    rank           - Numerical rank of the matrix.
+         *    piv            - Indices of the nonzero rows of the Cholesky factor.
+         *    W              - Input matrix, overwritten by its first rank orthonormal columns.
+         *    R              - Cholesky factor.
+         *    ld             - Leading dimension of R.
+         *    work           - Workspace array of size rank * rank. */
+        template<bool excluded, class K>
+        static inline void orthonormalize(const int& n, const int& rank, const int* const piv, K* const W, const K* const R, const int& ld, K* const work) {
+            for(int t = 0; t < rank; ++t) {
+                for(int u = 0; u <= t; ++u)
+                    work[u + t * rank] = R[piv[u] + piv[t] * ld];
+                if(!excluded && piv[t] != t)
+                    std::copy_n(W + piv[t] * n, n, W + t * n);
+            }
+            if(!excluded && rank > 0)
+                Wrapper<K>::trsm("R", "U", "N", "N", &n, &rank, &(Wrapper<K>::d__1), work, &rank, W, &n);
+        }
+        /* Function: orthogonalize
+         *
+         *  Orthogonalizes a block of vectors against an orthonormal basis, and computes an orthonormal basis of the range of the resulting block. The first pass requires a single fused reduction. A second pass is performed if a Cholesky pivot is lower than half the squared norm of the corresponding vector.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    n              - Number of local rows.
+         *    cols           - Number of vectors in the orthonormal basis.
+         *    p              - Number of vectors in the block.
+         *    V              - Orthonormal basis, immediately followed by the block which is overwritten by its orthonormal basis.
+         *    h              - Coefficients of the block in the new orthonormal basis.
+         *    ld             - Leading dimension of h.
+         *    work           - Workspace array of size (cols + p) * p.
+         *    tri            - Workspace array of size p * p.
+         *    g              - Workspace array of size p.
+         *    piv            - Indices of the nonzero rows of the upper trapezoidal part of h, must be of size 2 * p.
+         *    comm           - Global MPI communicator.
+         *
+         * Returns the numerical rank of the block. */
+        template<bool excluded, class K>
+        static inline int orthogonalize(const int& n, const int& cols, const int& p, K* const V, K* const h, const int& ld, K* const work, K* const tri,
+                                        typename Wrapper<K>::ul_type* const g, int* const piv, const MPI_Comm& comm) {
+            const typename Wrapper<K>::ul_type threshold = std::pow(std::max(static_cast<typename Wrapper<K>::ul_type>(HPDDM_EPS), 100 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()), 2);
+            K* const W = V + cols * n;
+            int* const pivot = piv + p;
+            for(int c = 0; c < p; ++c) {
+                h[cols + c + c * ld] = Wrapper<K>::d__1;
+                piv[c] = c;
+            }
+            int q = p;
+            for(unsigned short pass = 0; pass < 2 && q > 0; ++pass) {
+                const int rows = cols + q;
+                double time = History::tic();
+                if(excluded)
+                    std::fill_n(work, rows * q, K());
+                else
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &rows, &q, &n, &(Wrapper<K>::d__1), V, &n, W, &n, &(Wrapper<K>::d__0), work, &rows);
+                History::toc(History::ORTHOGONALIZATION, time);
+                time = History::tic();
+                MPI_Allreduce(MPI_IN_PLACE, work, rows * q, Wrapper<K>::mpi_type(), MPI_SUM, comm);                                // [V W]^H W
+                History::toc(History::REDUCTION, time);
+                time = History::tic();
+                for(int c = 0; c < q; ++c)
+                    g[c] = std::real(work[cols + c + c * rows]);
+                if(cols > 0) {
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &q, &q, &cols, &(Wrapper<K>::d__2), work, &rows, work, &rows, &(Wrapper<K>::d__1), work + cols, &rows);
+                    if(!excluded)
+                        Wrapper<K>::gemm(&transa, &transa, &n, &q, &cols, &(Wrapper<K>::d__2), V, &n, work, &rows, &(Wrapper<K>::d__1), W, &n); // W = W - V V^H W
+                    Wrapper<K>::gemm(&transa, &transa, &cols, &p, &q, &(Wrapper<K>::d__1), work, &rows, h + cols, &ld, &(Wrapper<K>::d__1), h, &ld);
+                }
+                const int rank = cholesky(q, work + cols, rows, g, threshold, pivot);
+                orthonormalize<excluded>(n, rank, pivot, W, work + cols, rows, tri);
+                bool reorthogonalize = false;
+                for(int t = 0; t < rank; ++t) {
+                    if(std::norm(work[cols + pivot[t] + pivot[t] * rows]) < 0.5 * g[pivot[t]])
+                        reorthogonalize = true;
+                    for(int c = 0; c < p; ++c) {
+                        K alpha = K();
+                        for(int u = pivot[t]; u < q; ++u)
+                            alpha += work[cols + pivot[t] + u * rows] * h[cols + u + c * ld];
+                        tri[t + c * rank] = alpha;
+                    }
+                    pivot[t] = piv[pivot[t]];
+                }
+                for(int c = 0; c < p; ++c) {
+                    std::copy_n(tri + c * rank, rank, h + cols + c * ld);
+                    std::fill(h + cols + rank + c * ld, h + cols + q + c * ld, K());
+                }
+                std::copy_n(pivot, rank, piv);
+                q = rank;
+                History::toc(History::ORTHOGONALIZATION, time);
+                if(!reorthogonalize)
+                    break;
+            }
+            return q;
+        }
+        /* Function: inner
+         *  Computes the local inner products of a block of contiguous vectors with a single vector, or sets them to zero if the master processes are excluded from the domain decomposition. */
+        template<bool excluded, class K>
+        static inline void inner(const int& n, const int& cols, const K* const V, const K* const w, K* const h) {
+            if(!excluded && n)
+                Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &cols, &(Wrapper<K>::d__1), V, &n, w, &i__1, &(Wrapper<K>::d__0), h, &i__1);
+            else
+                std::fill_n(h, cols, K());
+        }
         template<class T, typename std::enable_if<std::is_pointer<T>::value>::type* = nullptr>
         static inline void clean(T* const& pt) {
-            delete [] *pt;
-            delete []  pt;
+            Workspace::release(*pt);
+            delete [] pt;
         }
         template<class T, typename std::enable_if<!std::is_pointer<T>::value>::type* = nullptr>
         static inline void clean(T* const& pt) {
-            delete [] pt;
+            Workspace::release(pt);
         }
         template<class K, class T, typename std::enable_if<std::is_pointer<T>::value>::type* = nullptr>
         static inline void axpy(const int* const n, const K* const a, const T* const x, const int* const incx, T* const y, const int* const incy) {
@@ -96,6 +319,16 @@ class IterativeMethod {
             static_assert(std::is_same<T, K>::value, "Wrong types");
             Wrapper<T>::axpy(n, a, x, incx, y, incy);
         }
+        template<class K, class T, typename std::enable_if<std::is_pointer<T>::value>::type* = nullptr>
+        static inline void axpby(const int& n, const K& a, const T* const x, const K& b, T* const y) {
+            static_assert(std::is_same<typename std::remove_pointer<T>::type, K>::value, "Wrong types");
+            Wrapper<K>::axpby(n, a, *x, 1, b, *y, 1);
+        }
+        template<class K, class T, typename std::enable_if<!std::is_pointer<T>::value>::type* = nullptr>
+        static inline void axpby(const int& n, const K& a, const T* const x, const K& b, T* const y) {
+            static_assert(std::is_same<T, K>::value, "Wrong types");
+            Wrapper<T>::axpby(n, a, x, 1, b, y, 1);
+        }
         template<class T, typename std::enable_if<std::is_pointer<T>::value>::type* = nullptr>
         static inline typename std::remove_pointer<T>::type dot(const int* const n, const T* const x, const int* const incx, const T* const y, const int* const incy) {
             return Wrapper<typename std::remove_pointer<T>::type>::dot(n, *x, incx, *y, incy) / 2.0;
@@ -121,6 +354,7 @@ class IterativeMethod {
          * Template Parameters:
          *    Type           - See <Gmres>.
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    flexible       - True for the flexible GMRES, i.e. with a variable right preconditioner, false for the left-preconditioned GMRES. Only available with the classical Gram-Schmidt procedure, since the recurrences of the pipelined variants only hold for a fixed preconditioner.
          *    K              - Scalar type.
          *
          * Parameters:
@@ -132,30 +366,38 @@ class IterativeMethod {
          *    tol            - Tolerance for relative residual decrease.
          *    comm           - Global MPI communicator.
          *    verbosity      - Level of verbosity. */
-        template<Gmres Type = CLASSICAL, bool excluded = false, class Operator, class K>
+        template<Gmres Type = CLASSICAL, bool excluded = false, bool flexible = false, class Operator, class K>
         static inline int GMRES(const Operator& A, K* const x, const K* const b,
-                                unsigned short& m, unsigned short& it, typename Wrapper<K>::ul_type tol,
+                                index_type& m, index_type& it, typename Wrapper<K>::ul_type tol,
                                 const MPI_Comm& comm, unsigned short verbosity) {
+            static_assert(!flexible || Type == CLASSICAL, "The flexible GMRES is only available with the classical Gram-Schmidt procedure");
             const int n = excluded ? 0 : A.getDof();
             m = std::min(m, it);
-            K* const storage = new K[3 * (m + 1) + 2 * n];
+            K* const storage = Workspace::get<K>(3 * (m + 1) + 2 * n);
             K* s = storage;
             K* cs = storage + m + 1;
             K* sn = storage + 2 * m + 2;
             K* r = storage + 3 * m + 3;
             K* Ax = r + n;
-            std::copy(b, b + n, Ax);
-            A.template apply<excluded>(Ax, r);
-            storage[0] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            if(flexible)
+                storage[0] = Wrapper<K>::dot(&n, b, &i__1, b, &i__1);
+            else {
+                std::copy(b, b + n, Ax);
+                A.template apply<excluded>(Ax, r);
+                storage[0] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            }
 
             if(!excluded) {
-                for(unsigned int i = 0; i < n; ++i)
+                for(int i = 0; i < n; ++i)
                     if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
                         depenalize(b[i], x[i]);
                 A.GMV(x, Ax);
             }
             Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
-            A.template apply<excluded>(Ax, r);
+            if(flexible)
+                std::copy(Ax, Ax + n, r);
+            else
+                A.template apply<excluded>(Ax, r);
             storage[1] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
             MPI_Allreduce(MPI_IN_PLACE, storage, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
 
@@ -174,76 +416,365 @@ class IterativeMethod {
                     norm = 1.0;
                 else {
                     it = 0;
-                    delete [] storage;
+                    Workspace::release(storage);
                     return 0;
                 }
             }
 
+            if(Type == SSTEP) {
+                const int ld = m + 1;
+                K* const v = Workspace::get<K>((m + 1) * n, true);
+                K* const H = Workspace::get<K>(2 * ld * m + 2 * ld * (HPDDM_SSTEP + 1) + HPDDM_SSTEP * HPDDM_SSTEP, true);
+                K* const R = H + ld * m;
+                K* const Z = R + ld * m;
+                K* const work = Z + ld * (HPDDM_SSTEP + 1);
+                K* const tri = work + ld * HPDDM_SSTEP;
+                typename Wrapper<K>::ul_type* const g = Workspace::get<typename Wrapper<K>::ul_type>(HPDDM_SSTEP);
+                int* const piv = Workspace::get<int>(2 * HPDDM_SSTEP);
+                typename Wrapper<K>::ul_type rho = 0.0;
+                index_type j = 1;
+                int i = 0;
+                bool converged = false;
+                while(j <= it) {
+                    Wrapper<K>::axpby(n, 1.0 / beta, r, 1, K(), v, 1);
+                    std::fill_n(s, m + 1, K());
+                    s[0] = beta;
+                    i = 0;
+                    while(i < static_cast<int>(m) && j <= it && !converged) {
+                        // Chebyshev basis on [0, rho] if an estimate of the spectral radius is available, monomial basis otherwise
+                        // left preconditioning, M A v_k = center v_k + super v_{k - 1} + sub v_{k + 1}, with first instead of sub for k = 0
+                        // so that B below is the matrix of M A in the s-step basis, and H is the Hessenberg matrix of M A in the orthonormal basis
+                        const int p = std::min(HPDDM_SSTEP, static_cast<int>(m) - i);
+                        const K center = rho / 2.0;
+                        const K first = (rho > 0.0 ? rho / 2.0 : 1.0);
+                        const K sub = (rho > 0.0 ? first / 2.0 : first);
+                        const K super = (rho > 0.0 ? first / 2.0 : K());
+                        for(int k = 0; k < p; ++k) {
+                            K* const w = v + (i + k + 1) * n;
+                            double t = History::tic();
+                            if(!excluded)
+                                A.GMV(v + (i + k) * n, Ax);
+                            History::toc(History::GMV, t);
+                            t = History::tic();
+                            A.template apply<excluded>(Ax, w);
+                            History::toc(History::APPLY, t);
+                            K alpha = -center;
+                            Wrapper<K>::axpy(&n, &alpha, v + (i + k) * n, &i__1, w, &i__1);
+                            if(k > 0) {
+                                alpha = -super;
+                                Wrapper<K>::axpy(&n, &alpha, v + (i + k - 1) * n, &i__1, w, &i__1);
+                            }
+                            alpha = Wrapper<K>::d__1 / (k > 0 ? sub : first);
+                            Wrapper<K>::scal(&n, &alpha, w, &i__1);
+                        }
+                        std::fill_n(Z, ld * (p + 1), K());
+                        Z[i] = Wrapper<K>::d__1;
+                        const int rank = orthogonalize<excluded>(n, i + 1, p, v, Z + ld, ld, work, tri, g, piv, comm);
+                        int q = 0;
+                        while(q < rank && piv[q] == q)
+                            ++q;
+                        if(q == 0)                                                                                              // invariant subspace, H(i + 1, i) = 0
+                            q = 1;
+                        // H_{:, i:i+q} Z_{i:i+q, 0:q} = Z B - H_{:, 0:i} Z_{0:i, 0:q}
+                        const int rows = i + q + 1;
+                        for(int k = 0; k < q; ++k)
+                            for(int l = 0; l < rows; ++l)
+                                work[l + k * ld] = center * Z[l + k * ld] + (k > 0 ? sub : first) * Z[l + (k + 1) * ld] + (k > 0 ? super * Z[l + (k - 1) * ld] : K());
+                        if(i > 0) {
+                            int tmp = i + 1;
+                            Wrapper<K>::gemm(&transa, &transa, &tmp, &q, &i, &(Wrapper<K>::d__2), H, &ld, Z, &ld, &(Wrapper<K>::d__1), work, &ld);
+                        }
+                        Wrapper<K>::trsm("R", "U", "N", "N", &rows, &q, &(Wrapper<K>::d__1), Z + i, &ld, work, &ld);
+                        for(int k = 0; k < q && j <= it; ++k, ++i) {
+                            K* const h = R + i * ld;
+                            std::copy_n(work + k * ld, i + 2, H + i * ld);
+                            std::copy_n(work + k * ld, i + 2, h);
+                            int tmp = i + 2;
+                            rho = std::max(rho, Wrapper<K>::nrm2(&tmp, h, &i__1));
+                            for(int l = 0; l < i; ++l)
+                                rotate(h[l], h[l + 1], cs[l], sn[l]);
+                            givens(h[i], h[i + 1], cs[i], sn[i]);
+                            rotate(s[i], s[i + 1], cs[i], sn[i]);
+                            History::iteration(std::abs(s[i + 1]) / norm);
+                            if(verbosity)
+                                std::cout << "GMRES: " << std::setw(3) << j << " " << std::scientific << std::abs(s[i + 1]) << " " <<  norm << " " <<  std::abs(s[i + 1]) / norm << " < " << tol << std::endl;
+                            if(std::abs(s[i + 1]) / norm <= tol) {
+                                converged = true;
+                                ++i;
+                                break;
+                            }
+                            ++j;
+                        }
+                    }
+                    if(!excluded && i > 0) {
+                        Wrapper<K>::trsm("L", "U", "N", "N", &i, &i__1, &(Wrapper<K>::d__1), R, &ld, s, &ld);
+                        Wrapper<K>::gemv(&transa, &n, &i, &(Wrapper<K>::d__1), v, &n, s, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+                    }
+                    if(converged || j > it)
+                        break;
+                    if(!excluded)
+                        A.GMV(x, Ax);
+                    Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+                    A.template apply<excluded>(Ax, r);
+                    beta = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                    MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    beta = std::sqrt(beta);
+                    if(verbosity)
+                        std::cout << "GMRES restart(" << m << "): " << j - 1 << " " << beta << " " <<  norm << " " <<  beta / norm << " < " << tol << std::endl;
+                }
+                it = j;
+                if(verbosity) {
+                    if(converged)
+                        std::cout << "GMRES converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
+                    else
+                        std::cout << "GMRES does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
+                }
+                Workspace::release(piv);
+                Workspace::release(g);
+                Workspace::release(H);
+                Workspace::release(v);
+                Workspace::release(storage);
+                return 0;
+            }
+
+            if(Type == CLASSICAL && HPDDM_LOWSYNC) {
+                // CGS2 with lagged normalization: the second Gram--Schmidt pass and the normalization of v_i are delayed until the reduction of v_i^H [v_i, A v_i], so that column i - 1 of the Hessenberg matrix is only known at iteration i
+                const int ld = m + 1;
+                K* const v = Workspace::get<K>((m + 2) * n, true);
+                K* const w = v + (m + 1) * n;
+                K* const z = flexible ? Workspace::get<K>(m * n) : nullptr;                                  // preconditioned directions
+                K* const H = Workspace::get<K>(2 * ld * m + 3 * ld, true);
+                K* const R = H + ld * m;
+                K* const h = R + ld * m;
+                K* const Hs = h + 2 * ld;
+                index_type j = 1;
+                int i = 0;
+                bool converged = false;
+                while(j <= it) {
+                    Wrapper<K>::axpby(n, 1.0 / beta, r, 1, K(), v, 1);
+                    std::fill_n(s, m + 1, K());
+                    s[0] = beta;
+                    for(i = 0; i <= static_cast<int>(m); ++i) {
+                        K* const u = v + i * n;
+                        int dim = i + 1;
+                        double t = History::tic();
+                        if(i < static_cast<int>(m)) {
+                            if(flexible) {
+                                std::copy_n(u, n, Ax);
+                                A.template apply<excluded>(Ax, z + i * n);
+                                History::toc(History::APPLY, t);
+                                if(!excluded) {
+                                    t = History::tic();
+                                    A.GMV(z + i * n, w);
+                                    History::toc(History::GMV, t);
+                                }
+                            }
+                            else {
+                                if(!excluded) {
+                                    A.GMV(u, Ax);
+                                    History::toc(History::GMV, t);
+                                    t = History::tic();
+                                }
+                                A.template apply<excluded>(Ax, w);
+                                History::toc(History::APPLY, t);
+                            }
+                            t = History::tic();
+                        }
+                        inner<excluded>(n, dim, v, u, h);                                                       // [V_{0:i-1}, v_i]^H v_i
+                        if(i < static_cast<int>(m))
+                            inner<excluded>(n, dim, v, w, h + dim);                                             // [V_{0:i-1}, v_i]^H A v_i
+                        History::toc(History::ORTHOGONALIZATION, t);
+                        t = History::tic();
+                        MPI_Allreduce(MPI_IN_PLACE, h, (1 + (i < static_cast<int>(m))) * dim, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        History::toc(History::REDUCTION, t);
+                        const typename Wrapper<K>::ul_type nu = std::sqrt(std::max(std::real(h[i]) - (i > 0 ? Wrapper<K>::dot(&i, h, &i__1, h, &i__1) : typename Wrapper<K>::ul_type()), typename Wrapper<K>::ul_type()));
+                        if(i > 0) {
+                            K* const c = H + (i - 1) * ld;
+                            Wrapper<K>::axpy(&i, &(Wrapper<K>::d__1), h, &i__1, c, &i__1);
+                            c[i] = nu;
+                            std::copy_n(c, dim, R + (i - 1) * ld);
+                            K* const l = R + (i - 1) * ld;
+                            for(int k = 0; k < i - 1; ++k)
+                                rotate(l[k], l[k + 1], cs[k], sn[k]);
+                            givens(l[i - 1], l[i], cs[i - 1], sn[i - 1]);
+                            rotate(s[i - 1], s[i], cs[i - 1], sn[i - 1]);
+                            History::iteration(std::abs(s[i]) / norm);
+                            if(verbosity)
+                                std::cout << "GMRES: " << std::setw(3) << j << " " << std::scientific << std::abs(s[i]) << " " <<  norm << " " <<  std::abs(s[i]) / norm << " < " << tol << std::endl;
+                            if(std::abs(s[i]) / norm <= tol) {
+                                converged = true;
+                                break;
+                            }
+                            if(++j > it || i == static_cast<int>(m))
+                                break;
+                        }
+                        if(nu < HPDDM_EPS * HPDDM_EPS)                                                          // invariant subspace
+                            break;
+                        const K alpha = K(1.0) / nu;
+                        K gamma = h[dim + i];
+                        for(int k = 0; k < i; ++k)
+                            gamma -= conj(h[k]) * h[dim + k];
+                        gamma *= alpha;
+                        t = History::tic();
+                        if(!excluded && i > 0) {
+                            Wrapper<K>::gemv(&transa, &n, &i, &(Wrapper<K>::d__2), v, &n, h, &i__1, &(Wrapper<K>::d__1), u, &i__1);
+                            if(flexible)
+                                Wrapper<K>::gemv(&transa, &n, &i, &(Wrapper<K>::d__2), z, &n, h, &i__1, &(Wrapper<K>::d__1), z + i * n, &i__1);
+                        }
+                        Wrapper<K>::scal(&n, &alpha, u, &i__1);
+                        if(flexible)
+                            Wrapper<K>::scal(&n, &alpha, z + i * n, &i__1);
+                        // A v_i = (A u_i - V_{0:i} H_{0:i,0:i-1} s) / nu and v_{i+1} = (A u_i - V_{0:i-1} V_{0:i-1}^H A u_i - v_i gamma) / nu
+                        if(i > 0)
+                            Wrapper<K>::gemv(&transa, &dim, &i, &(Wrapper<K>::d__1), H, &ld, h, &i__1, &(Wrapper<K>::d__0), Hs, &i__1);
+                        else
+                            *Hs = K();
+                        K* const c = H + i * ld;
+                        for(int k = 0; k < i; ++k)
+                            c[k] = (h[dim + k] - Hs[k]) * alpha;
+                        c[i] = (gamma - Hs[i]) * alpha;
+                        h[dim + i] = gamma;
+                        if(!excluded) {
+                            Wrapper<K>::gemv(&transa, &n, &dim, &(Wrapper<K>::d__2), v, &n, h + dim, &i__1, &(Wrapper<K>::d__1), w, &i__1);
+                            Wrapper<K>::axpby(n, alpha, w, 1, 0.0, u + n, 1);
+                        }
+                        History::toc(History::ORTHOGONALIZATION, t);
+                    }
+                    if(!excluded && i > 0) {
+                        Wrapper<K>::trsm("L", "U", "N", "N", &i, &i__1, &(Wrapper<K>::d__1), R, &ld, s, &ld);
+                        Wrapper<K>::gemv(&transa, &n, &i, &(Wrapper<K>::d__1), flexible ? z : v, &n, s, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+                    }
+                    if(converged || j > it)
+                        break;
+                    if(!excluded)
+                        A.GMV(x, Ax);
+                    Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+                    if(flexible)
+                        std::copy_n(Ax, n, r);
+                    else
+                        A.template apply<excluded>(Ax, r);
+                    beta = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                    MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    beta = std::sqrt(beta);
+                    if(verbosity)
+                        std::cout << "GMRES restart(" << m << "): " << j - 1 << " " << beta << " " <<  norm << " " <<  beta / norm << " < " << tol << std::endl;
+                }
+                it = j;
+                if(verbosity) {
+                    if(converged)
+                        std::cout << "GMRES converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
+                    else
+                        std::cout << "GMRES does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
+                }
+                Workspace::release(H);
+                Workspace::release(z);
+                Workspace::release(v);
+                Workspace::release(storage);
+                return 0;
+            }
+
             K** const v = new K*[(m + 1 + (Type == FUSED || Type == CLASSICAL)) * (1 + (Type != CLASSICAL))];
             if(!excluded) {
-                *v = new K[(m + 1 + (Type == FUSED || Type == CLASSICAL)) * (1 + (Type != CLASSICAL)) * n + (m + 2) * (m + 2) * (Type == FUSED)]();
-                for(unsigned short i = 1; i < (m + 1 + (Type == FUSED || Type == CLASSICAL)); ++i)
+                *v = Workspace::get<K>((m + 1 + (Type == FUSED || Type == CLASSICAL)) * (1 + (Type != CLASSICAL)) * n + (m + 2) * (m + 2) * (Type == FUSED), true);
+                for(index_type i = 1; i < (m + 1 + (Type == FUSED || Type == CLASSICAL)); ++i)
                     v[i] = *v + i * n;
                 if(Type != CLASSICAL)
-                    for(unsigned short i = 0; i < (m + 1 + (Type == FUSED)); ++i)
+                    for(index_type i = 0; i < (m + 1 + (Type == FUSED)); ++i)
                         v[m + 1 + (Type == FUSED) + i] = v[m + (Type == FUSED)] + i * (n + (m + 2) * (Type == FUSED));
             }
+            K* const z = flexible ? Workspace::get<K>(m * n) : nullptr;                                      // preconditioned directions
 
             K** const H = new K*[m];
             if(Type != FUSED || excluded) {
-                *H = new K[(m + 1) * m];
-                for(unsigned short i = 1; i < m; ++i)
+                *H = Workspace::get<K>((m + 1) * m);
+                for(index_type i = 1; i < m; ++i)
                     H[i] = *H + i * (m + 1);
             }
             else
-                for(unsigned short i = 0; i < m; ++i)
+                for(index_type i = 0; i < m; ++i)
                     H[i] = v[m + i + 3] + n;
 
-            unsigned short j = 1;
+            index_type j = 1;
             int i;
             if(Type != CLASSICAL)
-                it = std::max(it, static_cast<unsigned short>((it / m) * m + 3));
+                it = std::max(it, static_cast<index_type>((it / m) * m + 3));
             while(j <= it) {
                 Wrapper<K>::axpby(n, 1.0 / beta, r, 1, K(), v[0], 1);
                 s[0] = beta;
                 MPI_Request rq;
                 if(Type != CLASSICAL)
                     std::copy(*v, *v + n, v[m + 1]);
-                for(i = 0; i < m && j <= it; ++i, ++j) {
+                for(i = 0; i < static_cast<int>(m) && j <= it; ++i, ++j) {
 #if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
-                    if(Type == PIPELINED && i > 0)
+                    if(Type == PIPELINED && i > 0) {
+                        const double t = History::tic();
                         MPI_Iallreduce(MPI_IN_PLACE, H[i - 1], i + 1 - (i == 1), Wrapper<K>::mpi_type(), MPI_SUM, comm, &rq);
+                        History::toc(History::REDUCTION, t);
+                    }
 #endif
-                    if(!excluded)
-                        A.GMV(v[i + (Type != CLASSICAL) * (m + 1)], Ax);
-                    A.template apply<excluded>(Ax, v[m + (Type == CLASSICAL ? 1 : i + 2)], Type == FUSED ? i + (i > 1) : 0);
+                    double t = History::tic();
+                    if(flexible) {
+                        std::copy_n(v[i], n, Ax);
+                        A.template apply<excluded>(Ax, v[m + 1]);
+                        History::toc(History::APPLY, t);
+                        if(!excluded) {
+                            t = History::tic();
+                            std::copy_n(v[m + 1], n, z + i * n);
+                            A.GMV(z + i * n, v[m + 1]);
+                            History::toc(History::GMV, t);
+                        }
+                    }
+                    else {
+                        if(!excluded) {
+                            A.GMV(v[i + (Type != CLASSICAL) * (m + 1)], Ax);
+                            History::toc(History::GMV, t);
+                            t = History::tic();
+                        }
+                        A.template apply<excluded>(Ax, v[m + (Type == CLASSICAL ? 1 : i + 2)], Type == FUSED ? i + (i > 1) : 0);
+                        History::toc(History::APPLY, t);
+                    }
                     if(Type == CLASSICAL || i > 1) {
                         if(Type == CLASSICAL) {
                             if(excluded) {
+                                t = History::tic();
                                 std::fill(H[i], H[i] + i + 1, K());
                                 MPI_Allreduce(MPI_IN_PLACE, H[i], i + 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                                 beta = typename Wrapper<K>::ul_type();
                                 MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
                                 H[i][i + 1] = std::sqrt(beta);
+                                History::toc(History::REDUCTION, t);
                             }
                             else {
                                 int tmp = i + 1;
+                                t = History::tic();
                                 Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &tmp, &(Wrapper<K>::d__1), *v, &n, v[m + 1], &i__1, &(Wrapper<K>::d__0), H[i], &i__1);
+                                History::toc(History::ORTHOGONALIZATION, t);
+                                t = History::tic();
                                 MPI_Allreduce(MPI_IN_PLACE, H[i], i + 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                                History::toc(History::REDUCTION, t);
+                                t = History::tic();
                                 Wrapper<K>::gemv(&transa, &n, &tmp, &(Wrapper<K>::d__2), *v, &n, H[i], &i__1, &(Wrapper<K>::d__1), v[m + 1], &i__1);
                                 beta = Wrapper<K>::dot(&n, v[m + 1], &i__1, v[m + 1], &i__1);
+                                History::toc(History::ORTHOGONALIZATION, t);
+                                t = History::tic();
                                 MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                                History::toc(History::REDUCTION, t);
                                 H[i][i + 1] = std::sqrt(beta);
+                                t = History::tic();
                                 Wrapper<K>::axpby(n, K(1.0) / H[i][i + 1], v[m + 1], 1, 0.0, v[i + 1], 1);
+                                History::toc(History::ORTHOGONALIZATION, t);
                             }
                         }
                         else {
-                            if(Type == PIPELINED)
+                            if(Type == PIPELINED) {
+                                t = History::tic();
                                 MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                                History::toc(History::REDUCTION, t);
+                            }
                             H[i - 2][i - 1] = std::sqrt(H[i - 1][i]);
                             i -= 2;
                         }
-                        for(unsigned short k = 0; k < i; ++k) {
+                        for(int k = 0; k < i; ++k) {
                             K gamma = cs[k] * H[i][k] + sn[k] * H[i][k + 1];
                             H[i][k + 1] = -sn[k] * H[i][k] + cs[k] * H[i][k + 1];
                             H[i][k] = gamma;
@@ -255,6 +786,7 @@ class IterativeMethod {
                         H[i][i] = cs[i] * H[i][i] + sn[i] * H[i][i + 1];
                         s[i + 1] = -sn[i] * s[i];
                         s[i] *= cs[i];
+                        History::iteration(std::abs(s[i + 1]) / norm);
                         if(verbosity)
                             std::cout << "GMRES: " << std::setw(3) << j << " " << std::scientific << std::abs(s[i + 1]) << " " <<  norm << " " <<  std::abs(s[i + 1]) / norm << " < " << tol << std::endl;
                         if(std::abs(s[i + 1]) / norm <= tol)
@@ -278,8 +810,12 @@ class IterativeMethod {
                         }
                     }
                     if(Type != CLASSICAL) {
-                        if(Type == PIPELINED && i == 1)
+                        if(Type == PIPELINED && i == 1) {
+                            t = History::tic();
                             MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                            History::toc(History::REDUCTION, t);
+                        }
+                        t = History::tic();
                         int lda = n + (m + 2) * (Type == FUSED);
                         Wrapper<K>::gemv(&transa, &n, &i, &(Wrapper<K>::d__2), v[m + 2], &lda, H[i - 1], &i__1, &(Wrapper<K>::d__1), v[m + i + 2], &i__1);
                         if(i > 0) {
@@ -289,11 +825,12 @@ class IterativeMethod {
                         }
                         lda = i + 1;
                         Wrapper<K>::gemv(&transb, &n, &lda, &(Wrapper<K>::d__1), *v, &n, v[m + i + 2], &i__1, &(Wrapper<K>::d__0), H[i], &i__1);
+                        History::toc(History::ORTHOGONALIZATION, t);
                     }
                 }
-                if(j != it + 1 && i != m)
+                if(j != it + 1 && i != static_cast<int>(m))
                     break;
-                else if(i == m) {
+                else if(i == static_cast<int>(m)) {
                     if(j == it + 1) {
                         --i;
                         break;
@@ -302,11 +839,14 @@ class IterativeMethod {
                         if(Type != CLASSICAL)
                             i -= 2;
                         if(!excluded) {
-                            update(n, x, i, H, s, v);
+                            update(n, x, i, H, s, flexible ? &z : v);
                             A.GMV(x, Ax);
                         }
                         Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
-                        A.template apply<excluded>(Ax, r);
+                        if(flexible)
+                            std::copy(Ax, Ax + n, r);
+                        else
+                            A.template apply<excluded>(Ax, r);
                         beta = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
                         MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
                         beta = std::sqrt(beta);
@@ -315,13 +855,13 @@ class IterativeMethod {
                     }
                 }
             }
-            if(i == m && j != it + 1) {
+            if(i == static_cast<int>(m) && j != it + 1) {
                 --i;
                 if(Type != CLASSICAL)
                     i -= 2;
             }
             if(!excluded)
-                update(n, x, i + 1, H, s, v);
+                update(n, x, i + 1, H, s, flexible ? &z : v);
             it = j;
             if(verbosity) {
                 if(std::abs(s[i + 1]) / norm <= tol)
@@ -329,20 +869,22 @@ class IterativeMethod {
                 else
                     std::cout << "GMRES does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
             }
+            Workspace::release(z);
             if(!excluded)
-                delete [] *v;
+                Workspace::release(*v);
             delete [] v;
             if(Type != FUSED || excluded)
-                delete [] *H;
+                Workspace::release(*H);
             delete [] H;
-            delete [] storage;
+            Workspace::release(storage);
             return 0;
         }
-        /* Function: CG
+        /* Function: CBGMRES
          *
-         *  Implements the CG method.
+         *  Implements the GMRES with a compressed Krylov basis, i.e. stored in a lower precision. Matrix-vector products, the classical Gram-Schmidt procedure, the Hessenberg matrix, and the solution are computed with the precision of the global operator, while basis vectors are only rounded to the lower precision when they are stored, and converted back on the fly when they are read. Residuals are recomputed with the precision of the global operator at each restart.
          *
          * Template Parameters:
+         *    T              - Scalar type of the Krylov basis.
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
          *    K              - Scalar type.
          *
@@ -350,88 +892,149 @@ class IterativeMethod {
          *    A              - Global operator.
          *    x              - Solution vector.
          *    b              - Right-hand side.
+         *    m              - Maximum size of the Krylov subspace.
          *    it             - Maximum number of iterations.
          *    tol            - Tolerance for relative residual decrease.
          *    comm           - Global MPI communicator.
          *    verbosity      - Level of verbosity. */
-        template<bool excluded = false, class Operator, class K>
-        static inline int CG(Operator& A, K* const x, const K* const b,
-                             unsigned short& it, typename Wrapper<K>::ul_type tol,
-                             const MPI_Comm& comm, unsigned short verbosity) {
-            const int n = A.getDof();
-            typename Wrapper<K>::ul_type* dir;
-            K* p;
-            allocate(dir, p, n);
-            K* z = p + n;
-            K* r = p + 2 * n;
-            K* trash = p + 3 * n;
-            const typename Wrapper<K>::ul_type* const d = A.getScaling();
-
-            for(unsigned int i = 0; i < n; ++i)
-                if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
-                    depenalize(b[i], x[i]);
-            A.GMV(x, z);
-            std::copy(b, b + n, r);
-            Wrapper<K>::axpy(&n, &(Wrapper<K>::d__2), z, &i__1, r, &i__1);
-
-            A.apply(r, z);
+        template<class T, bool excluded = false, class Operator, class K>
+        static inline int CBGMRES(const Operator& A, K* const x, const K* const b,
+                                  index_type& m, index_type& it, typename Wrapper<K>::ul_type tol,
+                                  const MPI_Comm& comm, unsigned short verbosity) {
+            static_assert(std::is_same<K, typename Wrapper<K>::ul_type>::value == std::is_same<T, typename Wrapper<T>::ul_type>::value, "Wrong types");
+            const int n = excluded ? 0 : A.getDof();
+            m = std::min(m, it);
+            const int ld = m + 1;
+            K* const storage = Workspace::get<K>(ld * (m + 3) + 2 * n);
+            K* const s = storage;
+            K* const cs = s + ld;
+            K* const sn = cs + ld;
+            K* const H = sn + ld;
+            K* const r = H + ld * m;
+            K* const Ax = r + n;
+            T* const v = Workspace::get<T>(ld * n);
+            std::copy_n(b, n, Ax);
+            A.template apply<excluded>(Ax, r);
+            storage[0] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            if(!excluded) {
+                for(int i = 0; i < n; ++i)
+                    if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                        depenalize(b[i], x[i]);
+                A.GMV(x, Ax);
+            }
+            Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+            A.template apply<excluded>(Ax, r);
+            storage[1] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, storage, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
 
-            Wrapper<K>::diagv(n, d, z, p);
-            dir[0] = Wrapper<K>::dot(&n, z, &i__1, p, &i__1);
-            MPI_Allreduce(MPI_IN_PLACE, dir, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
-            typename Wrapper<K>::ul_type resInit = std::sqrt(dir[0]);
+            typename Wrapper<K>::ul_type norm = std::sqrt(std::real(storage[0]));
+            typename Wrapper<K>::ul_type beta = std::sqrt(std::real(storage[1]));
 
+            if(norm < HPDDM_EPS)
+                norm = 1.0;
             if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
                 if(verbosity)
                     std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
                 tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
             }
-            if(resInit <= tol)
-                it = 0;
+            if(beta / norm < tol) {
+                if(norm > 1.0 / HPDDM_EPS)
+                    norm = 1.0;
+                else {
+                    it = 0;
+                    Workspace::release(v);
+                    Workspace::release(storage);
+                    return 0;
+                }
+            }
 
-            std::copy(z, z + n, p);
-            unsigned short i = 0;
-            while(i++ < it) {
-                Wrapper<K>::diagv(n, d, r, trash);
-                dir[0] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
-                A.GMV(p, z);
-                Wrapper<K>::diagv(n, d, p, trash);
-                dir[1] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
-                MPI_Allreduce(MPI_IN_PLACE, dir, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
-                K alpha = dir[0] / dir[1];
-                Wrapper<K>::axpy(&n, &alpha, p, &i__1, x, &i__1);
-                alpha = -alpha;
-                Wrapper<K>::axpy(&n, &alpha, z, &i__1, r, &i__1);
-
-                A.apply(r, z);
-                Wrapper<K>::diagv(n, d, z, trash);
-                dir[1] = Wrapper<K>::dot(&n, r, &i__1, trash, &i__1);
-                dir[2] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
-                MPI_Allreduce(MPI_IN_PLACE, dir + 1, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
-                Wrapper<K>::axpby(n, 1.0, z, 1, dir[1] / dir[0], p, 1);
-
-                dir[0] = std::sqrt(dir[2]);
-                if(verbosity)
-                    std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << dir[0] << " " << resInit << " " << dir[0] / resInit << " < " << tol << std::endl;
-                if(dir[0] / resInit <= tol) {
-                    it = i;
-                    break;
+            index_type j = 1;
+            int i = 0;
+            bool converged = false;
+            while(j <= it) {
+                K alpha = 1.0 / beta;
+                Wrapper<K>::scal(&n, &alpha, r, &i__1);
+                std::copy_n(r, n, v);
+                std::fill_n(s, ld, K());
+                s[0] = beta;
+                for(i = 0; i < static_cast<int>(m) && j <= it; ++i) {
+                    T* const w = v + (i + 1) * n;
+                    K* const Hi = H + i * ld;
+                    if(!excluded) {
+                        std::copy_n(v + i * n, n, r);
+                        A.GMV(r, Ax);
+                    }
+                    A.template apply<excluded>(Ax, r);
+                    int dim = i + 1;
+                    for(int k = 0; k < dim; ++k) {
+                        const T* const vk = v + k * n;
+                        K gamma = K();
+                        for(int l = 0; l < n; ++l)
+                            gamma += conj(K(vk[l])) * r[l];
+                        Hi[k] = gamma;
+                    }
+                    MPI_Allreduce(MPI_IN_PLACE, Hi, dim, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    for(int k = 0; k < dim; ++k) {
+                        const T* const vk = v + k * n;
+                        for(int l = 0; l < n; ++l)
+                            r[l] -= Hi[k] * K(vk[l]);
+                    }
+                    beta = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                    MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    Hi[dim] = std::sqrt(beta);
+                    if(beta > 0.0) {
+                        alpha = 1.0 / std::sqrt(beta);
+                        Wrapper<K>::scal(&n, &alpha, r, &i__1);
+                    }
+                    std::copy_n(r, n, w);
+                    for(int k = 0; k < i; ++k)
+                        rotate(Hi[k], Hi[k + 1], cs[k], sn[k]);
+                    givens(Hi[i], Hi[i + 1], cs[i], sn[i]);
+                    rotate(s[i], s[i + 1], cs[i], sn[i]);
+                    History::iteration(std::abs(s[i + 1]) / norm);
+                    if(verbosity)
+                        std::cout << "CBGMRES: " << std::setw(3) << j << " " << std::scientific << std::abs(s[i + 1]) << " " <<  norm << " " <<  std::abs(s[i + 1]) / norm << " < " << tol << std::endl;
+                    if(std::abs(s[i + 1]) / norm <= tol) {
+                        converged = true;
+                        ++i;
+                        break;
+                    }
+                    ++j;
+                }
+                if(!excluded && i > 0) {
+                    Wrapper<K>::trsm("L", "U", "N", "N", &i, &i__1, &(Wrapper<K>::d__1), H, &ld, s, &ld);
+                    for(int k = 0; k < i; ++k) {
+                        const T* const vk = v + k * n;
+                        for(int l = 0; l < n; ++l)
+                            x[l] += s[k] * K(vk[l]);
+                    }
                 }
+                if(converged || j > it)
+                    break;
+                if(!excluded)
+                    A.GMV(x, Ax);
+                Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+                A.template apply<excluded>(Ax, r);
+                beta = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                beta = std::sqrt(beta);
+                if(verbosity)
+                    std::cout << "CBGMRES restart(" << m << "): " << j - 1 << " " << beta << " " <<  norm << " " <<  beta / norm << " < " << tol << std::endl;
             }
+            it = j;
             if(verbosity) {
-                if(dir[0] / resInit <= tol)
-                    std::cout << "CG converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                if(converged)
+                    std::cout << "CBGMRES converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
                 else
-                    std::cout << "CG does not converges after " << i - 1 << " iteration" << (i > 2 ? "s" : "") << std::endl;
+                    std::cout << "CBGMRES does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
             }
-            delete [] dir;
-            if(!std::is_same<K, typename Wrapper<K>::ul_type>::value)
-                delete [] p;
+            Workspace::release(v);
+            Workspace::release(storage);
             return 0;
         }
-        /* Function: PCG
+        /* Function: BGMRES
          *
-         *  Implements the projected CG method.
+         *  Implements the block GMRES. Each block Gram-Schmidt step requires a single fused reduction, unless a severe loss of orthogonality is detected. Linearly dependent directions are removed from the Krylov basis, and right-hand sides are removed from the block as soon as they converge.
          *
          * Template Parameters:
          *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
@@ -439,102 +1042,1486 @@ class IterativeMethod {
          *
          * Parameters:
          *    A              - Global operator.
-         *    x              - Solution vector.
-         *    f              - Right-hand side.
+         *    x              - Solution vectors.
+         *    b              - Right-hand sides.
+         *    mu             - Number of right-hand sides.
+         *    m              - Maximum number of blocks in the Krylov subspace.
          *    it             - Maximum number of iterations.
          *    tol            - Tolerance for relative residual decrease.
          *    comm           - Global MPI communicator.
          *    verbosity      - Level of verbosity. */
         template<bool excluded = false, class Operator, class K>
-        static inline int PCG(Operator& A, K* const x, const K* const f,
-                              unsigned short& it, typename Wrapper<K>::ul_type tol,
-                              const MPI_Comm& comm, unsigned short verbosity) {
-            typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
-            const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
-            const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
-            ptr_type storage[std::is_same<ptr_type, K*>::value ? 1 : 2];
-            // storage[0] = r
-            // storage[1] = lambda
-            A.allocateArray(storage);
-            auto m = A.getScaling();
-            if(std::is_same<ptr_type, K*>::value)
-                A.template start<excluded>(x + offset, f, nullptr, storage[0]);
-            else
-                A.template start<excluded>(x, f, storage[1], storage[0]);
+        static inline int BGMRES(const Operator& A, K* const x, const K* const b, const unsigned short& mu,
+                                 index_type& m, index_type& it, typename Wrapper<K>::ul_type tol,
+                                 const MPI_Comm& comm, unsigned short verbosity) {
+            const int n = excluded ? 0 : A.getDof();
+            m = std::min(m, it);
+            const int ldh = (m + 1) * mu;
+            K* const storage = Workspace::get<K>(2 * n * mu + ldh * (m + 2) * mu + (2 * m + 1) * mu * mu, true);
+            K* const r = storage;
+            K* const Ax = r + n * mu;
+            K* const H = Ax + n * mu;
+            K* const s = H + ldh * m * mu;
+            K* const work = s + ldh * mu;
+            K* const cs = work + ldh * mu;
+            K* const sn = cs + m * mu * mu;
+            K* const tri = sn + m * mu * mu;
+            K* const v = Workspace::get<K>((m + 1) * mu * n);
+            typename Wrapper<K>::ul_type* const norm = Workspace::get<typename Wrapper<K>::ul_type>(3 * mu);
+            typename Wrapper<K>::ul_type* const g = norm + 2 * mu;
+            int* const idx = Workspace::get<int>((m + 3) * mu);
+            int* const piv = idx + mu;
+            int* const bottom = piv + 2 * mu;
+
+            A.template apply<excluded>(b, r, mu, Ax);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                norm[nu] = Wrapper<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1);
+            if(!excluded) {
+                for(int i = 0; i < n * mu; ++i)
+                    if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                        depenalize(b[i], x[i]);
+                A.GMV(x, Ax, mu);
+            }
+            Wrapper<K>::axpby(n * mu, 1.0, b, 1, -1.0, Ax, 1);
+            A.template apply<excluded>(Ax, r, mu, v);
+            for(unsigned short nu = 0; nu < mu; ++nu)
+                norm[mu + nu] = Wrapper<K>::dot(&n, r + nu * n, &i__1, r + nu * n, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, norm, 2 * mu, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
 
             if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
                 if(verbosity)
                     std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
                 tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
             }
-            std::vector<ptr_type> z;
-            z.reserve(it);
-            ptr_type zCurr;
-            A.allocateSingle(zCurr);
-            z.emplace_back(zCurr);
-            if(!excluded)
-                A.precond(storage[0], zCurr);                                                              //     z_0 = M r_0
-
-            typename Wrapper<K>::ul_type resInit;
-            A.template computeDot<excluded>(&resInit, zCurr, zCurr, comm);
-            resInit = std::sqrt(resInit);
-
-            std::vector<ptr_type> p;
-            p.reserve(it);
-            ptr_type pCurr;
-            A.allocateSingle(pCurr);
-            p.emplace_back(pCurr);
+            int k = 0;
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                norm[nu] = std::sqrt(norm[nu]);
+                norm[mu + nu] = std::sqrt(norm[mu + nu]);
+                if(norm[nu] < HPDDM_EPS)
+                    norm[nu] = 1.0;
+                if(norm[mu + nu] / norm[nu] < tol) {
+                    if(norm[nu] > 1.0 / HPDDM_EPS)
+                        norm[nu] = 1.0;
+                    else
+                        continue;
+                }
+                if(k != nu)
+                    std::copy_n(r + nu * n, n, r + k * n);
+                idx[k++] = nu;
+            }
 
-            K* alpha = new K[excluded ? std::max(static_cast<unsigned short>(2), it) : 2 * it];
-            unsigned short i = 0;
-            typename Wrapper<K>::ul_type resRel = std::numeric_limits<typename Wrapper<K>::ul_type>::max();
-            while(i++ < it) {
-                if(!excluded) {
-                    A.template project<excluded, 'N'>(zCurr, pCurr);                                       //     p_i = P z_i
-                    for(unsigned short k = 0; k < i - 1; ++k)
-                        alpha[it + k] = dot(&n, z[k], &i__1, pCurr, &i__1);
-                    MPI_Allreduce(MPI_IN_PLACE, alpha + it, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm); // alpha_k = < z_k, p_i >
-                    for(unsigned short k = 0; k < i - 1; ++k) {
-                        alpha[it + k] /= -alpha[k];
-                        axpy(&n, alpha + it + k, p[k], &i__1, pCurr, &i__1);                               //     p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
+            index_type j = 1;
+            while(k > 0 && j <= it) {
+                const int ld = (m + 1) * k;
+                std::fill_n(H, ld * m * k, K());
+                std::fill_n(s, ld * k, K());
+                std::copy_n(r, n * k, v);
+                int p = orthogonalize<excluded>(n, 0, k, v, s, ld, work, tri, g, piv, comm);                                             // R_0 = V_0 S
+                int i = 0;
+                int dim = 0;
+                bool deflate = false;
+                while(i < static_cast<int>(m) && j <= it && p > 0) {
+                    const int cols = dim + p;
+                    K* const w = v + cols * n;
+                    K* const h = H + dim * ld;
+                    if(!excluded)
+                        A.GMV(v + dim * n, Ax, p);
+                    A.template apply<excluded>(Ax, w, p, r);
+                    const int rank = orthogonalize<excluded>(n, cols, p, v, h, ld, work, tri, g, piv, comm);
+                    for(int c = 0, t = 0; c < p; ++c) {
+                        while(t < rank && piv[t] <= c)
+                            ++t;
+                        bottom[dim + c] = cols + t - 1;
                     }
-                    A.apply(pCurr, zCurr);                                                                 //     z_i = F p_i
-
-                    A.allocateSingle(zCurr);
-                    if(std::is_same<ptr_type, K*>::value) {
-                        diagv(n, m, pCurr, zCurr);
-                        alpha[i - 1] = dot(&n, z.back(), &i__1, zCurr, &i__1);
-                        alpha[i]     = dot(&n, storage[0], &i__1, zCurr, &i__1);
+                    for(int c = 0; c < p; ++c) {
+                        K* const hc = h + c * ld;
+                        const int q = dim + c;
+                        for(int l = 0; l < q; ++l)
+                            for(int e = 0; e < bottom[l] - l; ++e)
+                                rotate(hc[bottom[l] - e - 1], hc[bottom[l] - e], cs[l * k + e], sn[l * k + e]);
+                        for(int e = 0; e < bottom[q] - q; ++e) {
+                            givens(hc[bottom[q] - e - 1], hc[bottom[q] - e], cs[q * k + e], sn[q * k + e]);
+                            for(int nu = 0; nu < k; ++nu)
+                                rotate(s[bottom[q] - e - 1 + nu * ld], s[bottom[q] - e + nu * ld], cs[q * k + e], sn[q * k + e]);
+                        }
                     }
-                    else {
-                        alpha[i - 1] = dot(&n, z.back(), &i__1, pCurr, &i__1);
-                        alpha[i]     = dot(&n, storage[0], &i__1, pCurr, &i__1);
+                    dim = cols;
+                    p = rank;
+                    int worst = 0;
+                    for(int c = 0; c < k; ++c) {
+                        norm[mu + idx[c]] = Wrapper<K>::nrm2(&p, s + dim + c * ld, &i__1);
+                        if(norm[mu + idx[c]] / norm[idx[c]] <= tol)
+                            deflate = true;
+                        if(norm[mu + idx[c]] / norm[idx[c]] > norm[mu + idx[worst]] / norm[idx[worst]])
+                            worst = c;
                     }
-                    MPI_Allreduce(MPI_IN_PLACE, alpha + i - 1, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
-                    alpha[it] = alpha[i] / alpha[i - 1];
-                    if(std::is_same<ptr_type, K*>::value)
-                        axpy(&n, alpha + it, pCurr, &i__1, x + offset, &i__1);
-                    else
-                        axpy(&n, alpha + it, pCurr, &i__1, storage[1], &i__1);                             // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
-                    alpha[it] = -alpha[it];
-                    axpy(&n, alpha + it, z.back(), &i__1, storage[0], &i__1);                              // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
-                    A.template project<excluded, 'T'>(storage[0]);                                         // r_i + 1 = P^T r_i + 1
+                    History::iteration(norm[mu + idx[worst]] / norm[idx[worst]]);
+                    if(verbosity)
+                        std::cout << "BGMRES: " << std::setw(3) << j << " " << std::scientific << norm[mu + idx[worst]] << " " <<  norm[idx[worst]] << " " <<  norm[mu + idx[worst]] / norm[idx[worst]] << " < " << tol << std::endl;
+                    ++i;
+                    ++j;
+                    if(deflate)
+                        break;
+                }
+                if(dim == 0)
+                    break;
+                Wrapper<K>::trsm("L", "U", "N", "N", &dim, &k, &(Wrapper<K>::d__1), H, &ld, s, &ld);
+                if(!excluded) {
+                    Wrapper<K>::gemm(&transa, &transa, &n, &k, &dim, &(Wrapper<K>::d__1), v, &n, s, &ld, &(Wrapper<K>::d__0), Ax, &n);
+                    for(int c = 0; c < k; ++c)
+                        Wrapper<K>::axpy(&n, &(Wrapper<K>::d__1), Ax + c * n, &i__1, x + idx[c] * n, &i__1);
+                }
+                int active = 0;
+                for(int c = 0; c < k; ++c)
+                    if(norm[mu + idx[c]] / norm[idx[c]] > tol)
+                        idx[active++] = idx[c];
+                k = active;
+                if(k == 0 || j > it)
+                    break;
+                if(!excluded) {
+                    for(int c = 0; c < k; ++c)
+                        std::copy_n(x + idx[c] * n, n, r + c * n);
+                    A.GMV(r, Ax, k);
+                    for(int c = 0; c < k; ++c)
+                        Wrapper<K>::axpby(n, 1.0, b + idx[c] * n, 1, -1.0, Ax + c * n, 1);
+                }
+                A.template apply<excluded>(Ax, r, k, v);
+                if(verbosity)
+                    std::cout << "BGMRES restart(" << m << "): " << j - 1 << " " << k << " right-hand side" << (k > 1 ? "s" : "") << " left" << std::endl;
+            }
+            it = j - 1;
+            if(verbosity) {
+                if(k == 0)
+                    std::cout << "BGMRES converges after " << it << " iteration" << (it > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "BGMRES does not converges after " << it << " iteration" << (it > 1 ? "s" : "") << std::endl;
+            }
+            Workspace::release(idx);
+            Workspace::release(norm);
+            Workspace::release(v);
+            Workspace::release(storage);
+            return 0;
+        }
+        /* Function: GCRODR
+         *
+         *  Implements the GCRO-DR, i.e. a restarted GMRES which deflates a subspace spanned by harmonic Ritz vectors. The subspace is stored in a <Recycling> object, and is reused by subsequent calls, e.g. for sequences of linear systems with slowly changing operators.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    b              - Right-hand side.
+         *    recycling      - Recycled subspace, updated on exit.
+         *    m              - Maximum size of the search space, i.e. recycled subspace plus Krylov subspace.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<bool excluded = false, class Operator, class K>
+        static inline int GCRODR(const Operator& A, K* const x, const K* const b, Recycling<K>& recycling,
+                                 index_type& m, index_type& it, typename Wrapper<K>::ul_type tol,
+                                 const MPI_Comm& comm, unsigned short verbosity) {
+            const int n = excluded ? 0 : A.getDof();
+            const int k = recycling._k;
+            m = std::max(std::min(m, it), static_cast<index_type>(k + 1));
+            if(recycling._n != n || recycling._U.size() != static_cast<std::size_t>(2 * n * k)) {
+                std::vector<K>(2 * n * k).swap(recycling._U);
+                recycling._n = n;
+                recycling._dim = 0;
+            }
+            K* const U = recycling._U.data();
+            K* const C = U + n * k;
+            const int ld = m + 1;
+            K* const storage = Workspace::get<K>((m + 3 + k) * n + 5 * ld * m + ld + 8 * m + 3 * ld * k + 2 * k * k + 2 * k + 2);
+            K* const r = storage;
+            K* const Ax = r + n;
+            K* const tmp = Ax + n;
+            K* const v = tmp + n * k;
+            K* const G = v + ld * n;
+            K* const H = G + ld * m;
+            K* const WV = H + ld * m;
+            K* const S = WV + ld * m;
+            K* const GG = S + ld * m;
+            K* const g = GG + ld * m;
+            K* const cs = g + ld;
+            K* const sn = cs + m;
+            K* const Z = sn + m;
+            K* const P = Z + ld * k;
+            K* const Y = P + ld * k;
+            K* const tri = Y + ld * k;
+            K* const red = tri + 2 * k * k;
+            K* const wr = red + 2 * k + 2;
+            K* const wi = wr + m;
+            K* const work = wi + m;
+            typename Wrapper<K>::ul_type* const d = Workspace::get<typename Wrapper<K>::ul_type>(k + 2 * m);
+            typename Wrapper<K>::ul_type* const diag = d + k;
+            int* const piv = Workspace::get<int>(2 * m);
+            const typename Wrapper<K>::ul_type threshold = std::pow(std::max(static_cast<typename Wrapper<K>::ul_type>(HPDDM_EPS), 100 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()), 2);
+
+            std::copy(b, b + n, Ax);
+            A.template apply<excluded>(Ax, r);
+            typename Wrapper<K>::ul_type norm = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            if(!excluded) {
+                for(int i = 0; i < n; ++i)
+                    if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                        depenalize(b[i], x[i]);
+                A.GMV(x, Ax);
+            }
+            Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+            A.template apply<excluded>(Ax, r);
+
+            int q = recycling._dim;
+            if(q > 0) {
+                for(int i = 0; i < q; ++i) {
+                    if(!excluded)
+                        A.GMV(U + i * n, Ax);
+                    A.template apply<excluded>(Ax, C + i * n);
+                }
+                if(excluded)
+                    std::fill_n(tri, q * q, K());
+                else
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &q, &q, &n, &(Wrapper<K>::d__1), C, &n, C, &n, &(Wrapper<K>::d__0), tri, &q);
+                MPI_Allreduce(MPI_IN_PLACE, tri, q * q, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                for(int i = 0; i < q; ++i)
+                    diag[i] = std::real(tri[i + i * q]);
+                const int rank = cholesky(q, tri, q, diag, threshold, piv);                                                            // C = Q R
+                orthonormalize<excluded>(n, rank, piv, C, tri, q, tri + k * k);
+                orthonormalize<excluded>(n, rank, piv, U, tri, q, tri + k * k);                                                       // U = U R^-1
+                q = rank;
+            }
+
+            index_type j = 1;
+            bool first = true;
+            bool converged = false;
+            while(true) {
+                const int count = 1 + 2 * q + first;
+                red[0] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                if(!excluded && q > 0) {
+                    Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &q, &(Wrapper<K>::d__1), C, &n, r, &i__1, &(Wrapper<K>::d__0), red + 1, &i__1);
+                    for(int i = 0; i < q; ++i)
+                        red[1 + q + i] = Wrapper<K>::dot(&n, U + i * n, &i__1, U + i * n, &i__1);
+                }
+                else
+                    std::fill_n(red + 1, 2 * q, K());
+                if(first)
+                    red[count - 1] = norm;
+                MPI_Allreduce(MPI_IN_PLACE, red, count, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                typename Wrapper<K>::ul_type beta = std::real(red[0]);
+                for(int i = 0; i < q; ++i) {
+                    beta -= std::norm(red[1 + i]);
+                    d[i] = 1.0 / std::sqrt(std::real(red[1 + q + i]));
+                }
+                beta = std::sqrt(std::max(beta, static_cast<typename Wrapper<K>::ul_type>(0.0)));
+                if(!excluded && q > 0) {
+                    Wrapper<K>::gemv(&transa, &n, &q, &(Wrapper<K>::d__1), U, &n, red + 1, &i__1, &(Wrapper<K>::d__1), x, &i__1);  // x = x + U C^H r
+                    Wrapper<K>::gemv(&transa, &n, &q, &(Wrapper<K>::d__2), C, &n, red + 1, &i__1, &(Wrapper<K>::d__1), r, &i__1);  // r = r - C C^H r
+                }
+                if(first) {
+                    first = false;
+                    norm = std::sqrt(std::real(red[count - 1]));
+                    if(norm < HPDDM_EPS)
+                        norm = 1.0;
+                    if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                        if(verbosity)
+                            std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                        tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+                    }
+                    if(beta / norm < tol) {
+                        if(norm > 1.0 / HPDDM_EPS)
+                            norm = 1.0;
+                        else {
+                            it = 0;
+                            recycling._dim = q;
+                            Workspace::release(piv);
+                            Workspace::release(d);
+                            Workspace::release(storage);
+                            return 0;
+                        }
+                    }
+                }
+                else if(verbosity)
+                    std::cout << "GCRODR restart(" << m << ", " << q << "): " << j - 1 << " " << beta << " " <<  norm << " " <<  beta / norm << " < " << tol << std::endl;
+
+                // Arnoldi process on (I - C C^H) M A, G = [ D B ; 0 H ] with D = diag(d) and B = C^H M A V
+                std::fill_n(G, 2 * ld * m, K());
+                std::fill_n(g, ld, K());
+                for(int i = 0; i < q; ++i)
+                    G[i + i * ld] = H[i + i * ld] = d[i];
+                g[q] = beta;
+                Wrapper<K>::axpby(n, 1.0 / beta, r, 1, K(), v, 1);
+                int dim = q;
+                for(int l = 0; l < static_cast<int>(m) - q && j <= it; ++l) {
+                    K* const w = v + (l + 1) * n;
+                    K* const h = H + dim * ld;
+                    if(!excluded)
+                        A.GMV(v + l * n, Ax);
+                    A.template apply<excluded>(Ax, w);
+                    int cols = l + 1;
+                    if(excluded)
+                        std::fill_n(h, q + cols, K());
+                    else {
+                        Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &q, &(Wrapper<K>::d__1), C, &n, w, &i__1, &(Wrapper<K>::d__0), h, &i__1);
+                        Wrapper<K>::gemv(&(Wrapper<K>::transc), &n, &cols, &(Wrapper<K>::d__1), v, &n, w, &i__1, &(Wrapper<K>::d__0), h + q, &i__1);
+                    }
+                    MPI_Allreduce(MPI_IN_PLACE, h, q + cols, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    if(!excluded) {
+                        Wrapper<K>::gemv(&transa, &n, &q, &(Wrapper<K>::d__2), C, &n, h, &i__1, &(Wrapper<K>::d__1), w, &i__1);
+                        Wrapper<K>::gemv(&transa, &n, &cols, &(Wrapper<K>::d__2), v, &n, h + q, &i__1, &(Wrapper<K>::d__1), w, &i__1);
+                    }
+                    beta = Wrapper<K>::dot(&n, w, &i__1, w, &i__1);
+                    MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    beta = std::sqrt(beta);
+                    h[dim + 1] = beta;
+                    if(beta > 0.0) {
+                        K alpha = 1.0 / beta;
+                        Wrapper<K>::scal(&n, &alpha, w, &i__1);
+                    }
+                    K* const gc = G + dim * ld;
+                    std::copy_n(h, dim + 2, gc);
+                    for(int t = q; t < dim; ++t)
+                        rotate(gc[t], gc[t + 1], cs[t], sn[t]);
+                    givens(gc[dim], gc[dim + 1], cs[dim], sn[dim]);
+                    rotate(g[dim], g[dim + 1], cs[dim], sn[dim]);
+                    ++dim;
+                    History::iteration(std::abs(g[dim]) / norm);
+                    if(verbosity)
+                        std::cout << "GCRODR: " << std::setw(3) << j << " " << std::scientific << std::abs(g[dim]) << " " <<  norm << " " <<  std::abs(g[dim]) / norm << " < " << tol << std::endl;
+                    if(std::abs(g[dim]) / norm <= tol) {
+                        converged = true;
+                        break;
+                    }
+                    ++j;
+                }
+                Wrapper<K>::trsm("L", "U", "N", "N", &dim, &i__1, &(Wrapper<K>::d__1), G, &ld, g, &ld);
+                for(int i = 0; i < q; ++i)
+                    g[i] *= d[i];
+                const int cols = dim - q;
+                if(!excluded) {
+                    Wrapper<K>::gemv(&transa, &n, &q, &(Wrapper<K>::d__1), U, &n, g, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+                    Wrapper<K>::gemv(&transa, &n, &cols, &(Wrapper<K>::d__1), v, &n, g + q, &i__1, &(Wrapper<K>::d__1), x, &i__1);
+                }
+
+                if(dim > k && k > 0) {
+                    // harmonic Ritz vectors, i.e. G^H G z = theta G^H W^H V z with V = [ U D V_0 ... ] and W = [ C V_0 ... ]
+                    std::fill_n(WV, ld * dim, K());
+                    if(q > 0) {
+                        int rows = q + cols + 1;
+                        if(excluded)
+                            std::fill_n(P, rows * q, K());
+                        else {
+                            Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &q, &q, &n, &(Wrapper<K>::d__1), C, &n, U, &n, &(Wrapper<K>::d__0), P, &rows);
+                            int next = cols + 1;
+                            Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &next, &q, &n, &(Wrapper<K>::d__1), v, &n, U, &n, &(Wrapper<K>::d__0), P + q, &rows);
+                        }
+                        MPI_Allreduce(MPI_IN_PLACE, P, rows * q, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        for(int i = 0; i < q; ++i)
+                            Wrapper<K>::axpby(rows, d[i], P + i * rows, 1, K(), WV + i * ld, 1);
+                    }
+                    for(int t = q; t < dim; ++t)
+                        WV[t + t * ld] = Wrapper<K>::d__1;
+                    int rows = dim + 1;
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &dim, &dim, &rows, &(Wrapper<K>::d__1), H, &ld, WV, &ld, &(Wrapper<K>::d__0), S, &ld);
+                    Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &dim, &dim, &rows, &(Wrapper<K>::d__1), H, &ld, H, &ld, &(Wrapper<K>::d__0), GG, &ld);
+                    for(int i = 0; i < dim; ++i)
+                        diag[i] = std::real(GG[i + i * ld]);
+                    // the small dense problems are solved by the first process only, since eigenvectors associated to close eigenvalues may differ from one process to another
+                    int rank = 0;
+                    int master;
+                    MPI_Comm_rank(comm, &master);
+                    if(master == 0 && cholesky(dim, GG, ld, diag, threshold, piv) == dim) {
+                        // the harmonic Ritz vectors associated to the eigenvalues of smallest magnitude are the eigenvectors of (G^H G)^-1 G^H W^H V associated to its eigenvalues of largest magnitude
+                        Wrapper<K>::trsm("L", "U", "C", "N", &dim, &dim, &(Wrapper<K>::d__1), GG, &ld, S, &ld);
+                        Wrapper<K>::trsm("L", "U", "N", "N", &dim, &dim, &(Wrapper<K>::d__1), GG, &ld, S, &ld);
+                        std::fill_n(wi, dim, K());
+                        const int lwork = 4 * m;
+                        int info;
+                        Wrapper<K>::geev("N", "V", &dim, S, &ld, wr, wi, nullptr, &i__1, GG, &dim, work, &lwork, diag, &info);
+                        int nu = 0;
+                        if(info == 0) {
+                            std::iota(piv, piv + dim, 0);
+                            std::sort(piv, piv + dim, [&](int lhs, int rhs) {
+                                const typename Wrapper<K>::ul_type a = std::hypot(std::abs(wr[lhs]), std::real(wi[lhs])), b = std::hypot(std::abs(wr[rhs]), std::real(wi[rhs]));
+                                return a > b || (a == b && lhs < rhs);
+                            });
+                            // a real eigenvector is stored in a single column, while a pair of complex conjugate eigenvectors of a real matrix is stored as its real and imaginary parts in two consecutive columns, the first one with a positive imaginary part
+                            for(int i = 0; i < dim && nu < k; ++i) {
+                                const int t = piv[i];
+                                if(std::real(wi[t]) < 0.0)
+                                    continue;
+                                const int width = 1 + (std::real(wi[t]) > 0.0);
+                                if(nu + width > k)
+                                    break;
+                                std::copy_n(GG + t * dim, width * dim, Z + nu * dim);
+                                nu += width;
+                            }
+                            // eigenvectors associated to close eigenvalues may be almost collinear, so the basis of their span is orthonormalized before being multiplied by G
+                            int count = 0;
+                            for(int c = 0; c < nu; ++c) {
+                                K* const z = Z + count * dim;
+                                if(c != count)
+                                    std::copy_n(Z + c * dim, dim, z);
+                                const typename Wrapper<K>::ul_type before = Wrapper<K>::nrm2(&dim, z, &i__1);
+                                for(unsigned short pass = 0; pass < 2 && count > 0; ++pass) {
+                                    Wrapper<K>::gemv(&(Wrapper<K>::transc), &dim, &count, &(Wrapper<K>::d__1), Z, &dim, z, &i__1, &(Wrapper<K>::d__0), tri, &i__1);
+                                    Wrapper<K>::gemv(&transa, &dim, &count, &(Wrapper<K>::d__2), Z, &dim, tri, &i__1, &(Wrapper<K>::d__1), z, &i__1);
+                                }
+                                const typename Wrapper<K>::ul_type after = Wrapper<K>::nrm2(&dim, z, &i__1);
+                                if(after > std::sqrt(threshold) * before) {
+                                    K alpha = 1.0 / after;
+                                    Wrapper<K>::scal(&dim, &alpha, z, &i__1);
+                                    ++count;
+                                }
+                            }
+                            nu = count;
+                        }
+                        else if(verbosity)
+                            std::cout << "WARNING -- the harmonic Ritz vectors could not be computed, the recycled subspace is not updated" << std::endl;
+                        if(nu > 0) {
+                            // U = V Z R^-1, C = W Q with G Z = Q R
+                            Wrapper<K>::gemm(&transa, &transa, &rows, &nu, &dim, &(Wrapper<K>::d__1), H, &ld, Z, &dim, &(Wrapper<K>::d__0), Y, &rows);
+                            Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &nu, &nu, &rows, &(Wrapper<K>::d__1), Y, &rows, Y, &rows, &(Wrapper<K>::d__0), tri, &nu);
+                            for(int i = 0; i < nu; ++i)
+                                diag[i] = std::real(tri[i + i * nu]);
+                            rank = cholesky(nu, tri, nu, diag, threshold, piv);
+                            orthonormalize<false>(rows, rank, piv, Y, tri, nu, tri + k * k);
+                            orthonormalize<false>(dim, rank, piv, Z, tri, nu, tri + k * k);
+                        }
+                    }
+                    MPI_Bcast(&rank, 1, MPI_INT, 0, comm);
+                    if(rank > 0) {
+                        MPI_Bcast(Z, dim * rank, Wrapper<K>::mpi_type(), 0, comm);
+                        MPI_Bcast(Y, rows * rank, Wrapper<K>::mpi_type(), 0, comm);
+                        if(!excluded) {
+                            for(int i = 0; i < q; ++i)
+                                for(int c = 0; c < rank; ++c)
+                                    Z[i + c * dim] *= d[i];
+                            int next = cols + 1;
+                            Wrapper<K>::gemm(&transa, &transa, &n, &rank, &q, &(Wrapper<K>::d__1), U, &n, Z, &dim, &(Wrapper<K>::d__0), tmp, &n);
+                            Wrapper<K>::gemm(&transa, &transa, &n, &rank, &cols, &(Wrapper<K>::d__1), v, &n, Z + q, &dim, &(Wrapper<K>::d__1), tmp, &n);
+                            std::copy_n(tmp, n * rank, U);
+                            Wrapper<K>::gemm(&transa, &transa, &n, &rank, &q, &(Wrapper<K>::d__1), C, &n, Y, &rows, &(Wrapper<K>::d__0), tmp, &n);
+                            Wrapper<K>::gemm(&transa, &transa, &n, &rank, &next, &(Wrapper<K>::d__1), v, &n, Y + q, &rows, &(Wrapper<K>::d__1), tmp, &n);
+                            std::copy_n(tmp, n * rank, C);
+                        }
+                        q = rank;
+                    }
+                }
+                if(converged || j > it)
+                    break;
+                if(!excluded)
+                    A.GMV(x, Ax);
+                Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, Ax, 1);
+                A.template apply<excluded>(Ax, r);
+            }
+            recycling._dim = q;
+            it = j;
+            if(verbosity) {
+                if(converged)
+                    std::cout << "GCRODR converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "GCRODR does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
+            }
+            Workspace::release(piv);
+            Workspace::release(d);
+            Workspace::release(storage);
+            return 0;
+        }
+        /* Function: GMRESIR
+         *
+         *  Implements an iterative refinement around a flexible GMRES, e.g. for a preconditioner assembled in a lower precision, see <MixedPrecision>. Residuals and updates of the solution are computed with the precision of the global operator, while each correction is only computed up to a loose relative tolerance.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    b              - Right-hand side.
+         *    m              - Maximum size of the Krylov subspace of the inner solver.
+         *    it             - Maximum number of inner iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<bool excluded = false, class Operator, class K>
+        static inline int GMRESIR(const Operator& A, K* const x, const K* const b,
+                                  index_type& m, index_type& it, typename Wrapper<K>::ul_type tol,
+                                  const MPI_Comm& comm, unsigned short verbosity) {
+            const int n = excluded ? 0 : A.getDof();
+            K* const storage = Workspace::get<K>(2 * n);
+            K* const r = storage;
+            K* const d = storage + n;
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+            typename Wrapper<K>::ul_type norm[2];
+            index_type total = 0;
+            index_type j = 0;
+            bool converged = false;
+            while(true) {
+                if(!excluded)
+                    A.GMV(x, r);
+                Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);
+                norm[0] = Wrapper<K>::dot(&n, b, &i__1, b, &i__1);
+                norm[1] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+                MPI_Allreduce(MPI_IN_PLACE, norm, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                norm[0] = std::sqrt(norm[0]);
+                norm[1] = std::sqrt(norm[1]);
+                if(norm[0] < HPDDM_EPS)
+                    norm[0] = 1.0;
+                if(verbosity > 0)
+                    std::cout << "GMRESIR: " << std::setw(3) << j << " " << std::scientific << norm[1] << " " <<  norm[0] << " " <<  norm[1] / norm[0] << " < " << tol << std::endl;
+                if(norm[1] / norm[0] <= tol) {
+                    converged = true;
+                    break;
+                }
+                if(total >= it)
+                    break;
+                index_type inner = it - total;
+                index_type restart = m;
+                std::fill_n(d, n, K());
+                GMRES<CLASSICAL, excluded, true>(A, d, r, restart, inner, std::max(tol * norm[0] / norm[1], std::sqrt(tol)), comm, verbosity > 1 ? verbosity - 1 : 0);
+                Wrapper<K>::axpy(&n, &(Wrapper<K>::d__1), d, &i__1, x, &i__1);
+                total += std::max(inner, static_cast<index_type>(1));
+                ++j;
+            }
+            it = total;
+            if(verbosity) {
+                if(converged)
+                    std::cout << "GMRESIR converges after " << j << " refinement step" << (j > 1 ? "s" : "") << " and " << total << " iteration" << (total > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "GMRESIR does not converges after " << j << " refinement step" << (j > 1 ? "s" : "") << " and " << total << " iteration" << (total > 1 ? "s" : "") << std::endl;
+            }
+            Workspace::release(storage);
+            return 0;
+        }
+        /* Function: CG
+         *
+         *  Implements the CG method.
+         *
+         * Template Parameters:
+         *    Type           - See <Cg>.
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    b              - Right-hand side.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<Cg Type = Cg::CLASSICAL, bool excluded = false, class Operator, class K>
+        static inline int CG(Operator& A, K* const x, const K* const b,
+                             index_type& it, typename Wrapper<K>::ul_type tol,
+                             const MPI_Comm& comm, unsigned short verbosity) {
+            static_assert(Type != Cg::FUSED, "The single-reduction CG is only available for FETI and BDD, see PCG");
+            const int n = A.getDof();
+            typename Wrapper<K>::ul_type* dir;
+            K* p;
+            allocate(dir, p, n, Type == Cg::PIPELINED ? 10 : 4);
+            K* z = p + n;
+            K* r = p + 2 * n;
+            K* trash = p + 3 * n;
+            const typename Wrapper<K>::ul_type* const d = A.getScaling();
+
+            for(unsigned int i = 0; i < n; ++i)
+                if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                    depenalize(b[i], x[i]);
+            A.GMV(x, z);
+            std::copy(b, b + n, r);
+            Wrapper<K>::axpy(&n, &(Wrapper<K>::d__2), z, &i__1, r, &i__1);
+
+            A.apply(r, z);
+
+            typename Wrapper<K>::ul_type resInit = 0.0;
+            if(Type == Cg::CLASSICAL) {
+                Wrapper<K>::diagv(n, d, z, p);
+                dir[0] = Wrapper<K>::dot(&n, z, &i__1, p, &i__1);
+                MPI_Allreduce(MPI_IN_PLACE, dir, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                resInit = std::sqrt(dir[0]);
+            }
+
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+
+            index_type i = 0;
+            if(Type == Cg::CLASSICAL) {
+                if(resInit <= tol)
+                    it = 0;
+                std::copy(z, z + n, p);
+                while(i++ < it) {
+                    Wrapper<K>::diagv(n, d, r, trash);
+                    dir[0] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
+                    double t = History::tic();
+                    A.GMV(p, z);
+                    History::toc(History::GMV, t);
+                    Wrapper<K>::diagv(n, d, p, trash);
+                    dir[1] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, dir, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    K alpha = dir[0] / dir[1];
+                    Wrapper<K>::axpy(&n, &alpha, p, &i__1, x, &i__1);
+                    alpha = -alpha;
+                    Wrapper<K>::axpy(&n, &alpha, z, &i__1, r, &i__1);
+
+                    t = History::tic();
+                    A.apply(r, z);
+                    History::toc(History::APPLY, t);
+                    Wrapper<K>::diagv(n, d, z, trash);
+                    dir[1] = Wrapper<K>::dot(&n, r, &i__1, trash, &i__1);
+                    dir[2] = Wrapper<K>::dot(&n, z, &i__1, trash, &i__1);
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, dir + 1, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    Wrapper<K>::axpby(n, 1.0, z, 1, dir[1] / dir[0], p, 1);
+
+                    dir[0] = std::sqrt(dir[2]);
+                    History::iteration(dir[0] / resInit);
+                    if(verbosity)
+                        std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << dir[0] << " " << resInit << " " << dir[0] / resInit << " < " << tol << std::endl;
+                    if(dir[0] / resInit <= tol) {
+                        it = i;
+                        break;
+                    }
+                }
+            }
+            else {
+                K* const u = z;             // u = M r
+                K* const Ap = p + 4 * n;    // s = A p
+                K* const MAp = p + 5 * n;   // q = M s
+                K* const AMAp = p + 6 * n;  // z = A q
+                K* const Au = p + 7 * n;    // w = A u
+                K* const MAu = p + 8 * n;   // m = M w
+                K* const AMAu = p + 9 * n;  // n = A m
+                A.GMV(u, Au);
+                typename Wrapper<K>::ul_type alpha = 0.0, gamma = 0.0;
+                MPI_Request rq;
+                while(true) {
+                    Wrapper<K>::diagv(n, d, u, trash);
+                    dir[0] = Wrapper<K>::dot(&n, u, &i__1, trash, &i__1);
+                    dir[1] = Wrapper<K>::dot(&n, r, &i__1, trash, &i__1);
+                    dir[2] = Wrapper<K>::dot(&n, Au, &i__1, trash, &i__1);
+                    double t = History::tic();
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                    MPI_Iallreduce(MPI_IN_PLACE, dir, 3, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm, &rq);
+#else
+                    MPI_Allreduce(MPI_IN_PLACE, dir, 3, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                    rq = MPI_REQUEST_NULL;
+#endif
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
+                    A.apply(Au, MAu);
+                    History::toc(History::APPLY, t);
+                    t = History::tic();
+                    A.GMV(MAu, AMAu);
+                    History::toc(History::GMV, t);
+                    t = History::tic();
+                    MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                    History::toc(History::REDUCTION, t);
+                    dir[0] = std::sqrt(dir[0]);
+                    if(i == 0) {
+                        resInit = dir[0];
+                        if(resInit <= tol)
+                            it = 0;
+                    }
+                    else {
+                        History::iteration(dir[0] / resInit);
+                        if(verbosity)
+                            std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << dir[0] << " " << resInit << " " << dir[0] / resInit << " < " << tol << std::endl;
+                        if(dir[0] / resInit <= tol) {
+                            it = i;
+                            break;
+                        }
+                    }
+                    if(i++ == it)
+                        break;
+                    const typename Wrapper<K>::ul_type beta = (i > 1 ? dir[1] / gamma : 0.0);
+                    alpha = dir[1] / (i > 1 ? dir[2] - beta * dir[1] / alpha : dir[2]);
+                    gamma = dir[1];
+                    if(i > 1) {
+                        Wrapper<K>::axpby(n, 1.0, AMAu, 1, beta, AMAp, 1);
+                        Wrapper<K>::axpby(n, 1.0, MAu, 1, beta, MAp, 1);
+                        Wrapper<K>::axpby(n, 1.0, Au, 1, beta, Ap, 1);
+                        Wrapper<K>::axpby(n, 1.0, u, 1, beta, p, 1);
+                    }
+                    else {
+                        std::copy(AMAu, AMAu + n, AMAp);
+                        std::copy(MAu, MAu + n, MAp);
+                        std::copy(Au, Au + n, Ap);
+                        std::copy(u, u + n, p);
+                    }
+                    K scal = alpha;
+                    Wrapper<K>::axpy(&n, &scal, p, &i__1, x, &i__1);
+                    scal = -alpha;
+                    Wrapper<K>::axpy(&n, &scal, Ap, &i__1, r, &i__1);
+                    Wrapper<K>::axpy(&n, &scal, MAp, &i__1, u, &i__1);
+                    Wrapper<K>::axpy(&n, &scal, AMAp, &i__1, Au, &i__1);
+                }
+            }
+            if(verbosity) {
+                if(dir[0] / resInit <= tol)
+                    std::cout << "CG converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "CG does not converges after " << i - 1 << " iteration" << (i > 2 ? "s" : "") << std::endl;
+            }
+            Workspace::release(dir);
+            if(!std::is_same<K, typename Wrapper<K>::ul_type>::value)
+                Workspace::release(p);
+            return 0;
+        }
+        /* Function: BICGSTAB
+         *
+         *  Implements the right-preconditioned BiCGStab. The pipelined variant overlaps each of its two global reductions per iteration with an application of the preconditioner and a matrix-vector product.
+         *
+         * Template Parameters:
+         *    Type           - See <Bicgstab>.
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    b              - Right-hand side.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<Bicgstab Type = Bicgstab::CLASSICAL, bool excluded = false, class Operator, class K>
+        static inline int BICGSTAB(const Operator& A, K* const x, const K* const b,
+                                   index_type& it, typename Wrapper<K>::ul_type tol,
+                                   const MPI_Comm& comm, unsigned short verbosity) {
+            const int n = excluded ? 0 : A.getDof();
+            K* const storage = Workspace::get<K>((Type == Bicgstab::PIPELINED ? 16 : 8) * n, true);
+            K* const rt = storage;                                                                 // shadow residual
+            K* const r = rt + n;
+            K* const tmp = storage + (Type == Bicgstab::PIPELINED ? 15 : 7) * n;
+            K dot[5];
+            if(!excluded) {
+                for(int i = 0; i < n; ++i)
+                    if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                        depenalize(b[i], x[i]);
+                A.GMV(x, r);
+            }
+            Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);
+            std::copy_n(r, n, rt);
+            dot[0] = Wrapper<K>::dot(&n, b, &i__1, b, &i__1);
+            dot[1] = Wrapper<K>::dot(&n, r, &i__1, r, &i__1);
+            if(Type == Bicgstab::PIPELINED) {
+                std::copy_n(r, n, tmp);
+                A.template apply<excluded>(tmp, r + 4 * n);                                            // r^ = M r
+                if(!excluded)
+                    A.GMV(r + 4 * n, r + n);                                                           // w = A r^
+                std::copy_n(r + n, n, tmp);
+                A.template apply<excluded>(tmp, r + 5 * n);                                            // w^ = M w
+                if(!excluded)
+                    A.GMV(r + 5 * n, r + 6 * n);                                                       // t = A w^
+                inner<excluded>(n, 2, r, rt, dot + 2);
+            }
+            MPI_Allreduce(MPI_IN_PLACE, dot, Type == Bicgstab::PIPELINED ? 4 : 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+
+            typename Wrapper<K>::ul_type norm = std::sqrt(std::real(dot[0]));
+            typename Wrapper<K>::ul_type res = std::sqrt(std::real(dot[1]));
+            if(norm < HPDDM_EPS)
+                norm = 1.0;
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+            if(res / norm <= tol) {
+                it = 0;
+                Workspace::release(storage);
+                return 0;
+            }
+            index_type j = 1, start = 1;
+            bool converged = false, breakdown;
+            typename Wrapper<K>::ul_type shadow = res;                                                // norm of r~
+            K rho = dot[1];
+            K alpha = Wrapper<K>::d__1, omega = Wrapper<K>::d__1, beta = K();
+            if(Type == Bicgstab::CLASSICAL) {
+                K* const s = r;                                                                        // s overwrites r
+                K* const t = r + n;
+                K* const p = r + 2 * n;
+                K* const v = r + 3 * n;
+                K* const ph = r + 4 * n;
+                K* const sh = r + 5 * n;
+                while(j <= it && !converged) {
+                    double time = History::tic();
+                    if(j > start) {
+                        beta = (rho / dot[4]) * (alpha / omega);
+                        K scal = -omega;
+                        Wrapper<K>::axpy(&n, &scal, v, &i__1, p, &i__1);
+                        Wrapper<K>::axpby(n, 1.0, r, 1, beta, p, 1);                                  // p = r + beta (p - omega v)
+                    }
+                    else
+                        std::copy_n(r, n, p);
+                    std::copy_n(p, n, tmp);
+                    History::toc(History::ORTHOGONALIZATION, time);
+                    time = History::tic();
+                    A.template apply<excluded>(tmp, ph);
+                    History::toc(History::APPLY, time);
+                    time = History::tic();
+                    if(!excluded)
+                        A.GMV(ph, v);
+                    History::toc(History::GMV, time);
+                    inner<excluded>(n, 1, rt, v, dot);
+                    time = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, dot, 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, time);
+                    alpha = rho / dot[0];
+                    K scal = -alpha;
+                    Wrapper<K>::axpy(&n, &scal, v, &i__1, s, &i__1);                                   // s = r - alpha v
+                    std::copy_n(s, n, tmp);
+                    time = History::tic();
+                    A.template apply<excluded>(tmp, sh);
+                    History::toc(History::APPLY, time);
+                    time = History::tic();
+                    if(!excluded)
+                        A.GMV(sh, t);
+                    History::toc(History::GMV, time);
+                    inner<excluded>(n, 2, s, t, dot);
+                    time = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, dot, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, time);
+                    omega = std::real(dot[1]) > 0.0 ? conj(dot[0]) / dot[1] : K();                    // omega = (t, s) / (t, t)
+                    Wrapper<K>::axpy(&n, &alpha, ph, &i__1, x, &i__1);
+                    Wrapper<K>::axpy(&n, &omega, sh, &i__1, x, &i__1);
+                    scal = -omega;
+                    Wrapper<K>::axpy(&n, &scal, t, &i__1, r, &i__1);                                   // r = s - omega t
+                    inner<excluded>(n, 2, rt, r, dot + 2);
+                    time = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, dot + 2, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, time);
+                    res = std::sqrt(std::real(dot[3]));
+                    if(res / norm <= tol) {
+                        // the recursively updated residual may drift away from the true one, so convergence is only declared on the latter
+                        time = History::tic();
+                        if(!excluded)
+                            A.GMV(x, r);
+                        History::toc(History::GMV, time);
+                        Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);                                  // r = b - A x
+                        inner<excluded>(n, 2, rt, r, dot + 2);
+                        time = History::tic();
+                        MPI_Allreduce(MPI_IN_PLACE, dot + 2, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        History::toc(History::REDUCTION, time);
+                        res = std::sqrt(std::real(dot[3]));
+                    }
+                    dot[4] = rho;
+                    rho = dot[2];
+                    History::iteration(res / norm);
+                    if(verbosity)
+                        std::cout << "BICGSTAB: " << std::setw(3) << j << " " << std::scientific << res << " " <<  norm << " " <<  res / norm << " < " << tol << std::endl;
+                    if(res / norm <= tol)
+                        converged = true;
+                    else {
+                        ++j;
+                        if(omega == K() || std::abs(rho) <= std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() * res * shadow) {
+                            std::copy_n(r, n, rt);                                                     // breakdown, restart with r~ = r
+                            rho = dot[3];
+                            shadow = res;
+                            start = j;
+                        }
+                    }
+                }
+            }
+            else {
+                K* const w = r + n;
+                K* const s = r + 2 * n;
+                K* const z = r + 3 * n;
+                K* const rh = r + 4 * n;
+                K* const wh = r + 5 * n;
+                K* const t = r + 6 * n;
+                K* const ph = r + 7 * n;
+                K* const sh = r + 8 * n;
+                K* const zh = r + 9 * n;
+                K* const v = r + 10 * n;
+                K* const q = r + 11 * n;
+                K* const y = r + 12 * n;
+                K* const qh = r + 13 * n;
+                alpha = conj(dot[2]) / conj(dot[3]);
+                MPI_Request rq;
+                while(j <= it && !converged) {
+                    double time = History::tic();
+                    if(j > start) {
+                        K scal = -omega;
+                        Wrapper<K>::axpy(&n, &scal, sh, &i__1, ph, &i__1);
+                        Wrapper<K>::axpby(n, 1.0, rh, 1, beta, ph, 1);                                // p^ = r^ + beta (p^ - omega s^)
+                        Wrapper<K>::axpy(&n, &scal, z, &i__1, s, &i__1);
+                        Wrapper<K>::axpby(n, 1.0, w, 1, beta, s, 1);                                  // s = w + beta (s - omega z)
+                        Wrapper<K>::axpy(&n, &scal, zh, &i__1, sh, &i__1);
+                        Wrapper<K>::axpby(n, 1.0, wh, 1, beta, sh, 1);                                // s^ = w^ + beta (s^ - omega z^)
+                        Wrapper<K>::axpy(&n, &scal, v, &i__1, z, &i__1);
+                        Wrapper<K>::axpby(n, 1.0, t, 1, beta, z, 1);                                  // z = t + beta (z - omega v)
+                    }
+                    else {
+                        std::copy_n(rh, n, ph);
+                        std::copy_n(w, n, s);
+                        std::copy_n(wh, n, sh);
+                        std::copy_n(t, n, z);
+                    }
+                    K scal = -alpha;
+                    std::copy_n(r, n, q);
+                    Wrapper<K>::axpy(&n, &scal, s, &i__1, q, &i__1);                                   // q = r - alpha s
+                    std::copy_n(rh, n, qh);
+                    Wrapper<K>::axpy(&n, &scal, sh, &i__1, qh, &i__1);                                 // q^ = r^ - alpha s^
+                    std::copy_n(w, n, y);
+                    Wrapper<K>::axpy(&n, &scal, z, &i__1, y, &i__1);                                   // y = w - alpha z
+                    inner<excluded>(n, 2, q, y, dot);
+                    History::toc(History::ORTHOGONALIZATION, time);
+                    time = History::tic();
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                    MPI_Iallreduce(MPI_IN_PLACE, dot, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm, &rq);
+#else
+                    MPI_Allreduce(MPI_IN_PLACE, dot, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    rq = MPI_REQUEST_NULL;
+#endif
+                    History::toc(History::REDUCTION, time);
+                    std::copy_n(z, n, tmp);
+                    time = History::tic();
+                    A.template apply<excluded>(tmp, zh);
+                    History::toc(History::APPLY, time);
+                    time = History::tic();
+                    if(!excluded)
+                        A.GMV(zh, v);
+                    History::toc(History::GMV, time);
+                    time = History::tic();
+                    MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                    History::toc(History::REDUCTION, time);
+                    time = History::tic();
+                    omega = std::real(dot[1]) > 0.0 ? conj(dot[0]) / dot[1] : K();                    // omega = (y, q) / (y, y)
+                    Wrapper<K>::axpy(&n, &alpha, ph, &i__1, x, &i__1);
+                    Wrapper<K>::axpy(&n, &omega, qh, &i__1, x, &i__1);
+                    Wrapper<K>::axpy(&n, &scal, zh, &i__1, wh, &i__1);
+                    Wrapper<K>::axpy(&n, &scal, v, &i__1, t, &i__1);
+                    scal = -omega;
+                    std::copy_n(qh, n, rh);
+                    Wrapper<K>::axpy(&n, &scal, wh, &i__1, rh, &i__1);                                 // r^ = q^ - omega (w^ - alpha z^)
+                    std::copy_n(y, n, w);
+                    Wrapper<K>::axpy(&n, &scal, t, &i__1, w, &i__1);                                   // w = y - omega (t - alpha v)
+                    std::copy_n(q, n, r);
+                    Wrapper<K>::axpy(&n, &scal, y, &i__1, r, &i__1);                                   // r = q - omega y
+                    inner<excluded>(n, 4, r, rt, dot);
+                    inner<excluded>(n, 1, r, r, dot + 4);
+                    History::toc(History::ORTHOGONALIZATION, time);
+                    time = History::tic();
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                    MPI_Iallreduce(MPI_IN_PLACE, dot, 5, Wrapper<K>::mpi_type(), MPI_SUM, comm, &rq);
+#else
+                    MPI_Allreduce(MPI_IN_PLACE, dot, 5, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    rq = MPI_REQUEST_NULL;
+#endif
+                    History::toc(History::REDUCTION, time);
+                    std::copy_n(w, n, tmp);
+                    time = History::tic();
+                    A.template apply<excluded>(tmp, wh);
+                    History::toc(History::APPLY, time);
+                    time = History::tic();
+                    if(!excluded)
+                        A.GMV(wh, t);
+                    History::toc(History::GMV, time);
+                    time = History::tic();
+                    MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                    History::toc(History::REDUCTION, time);
+                    res = std::sqrt(std::real(dot[4]));
+                    breakdown = (omega == K() || std::abs(dot[0]) <= std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() * res * shadow);
+                    if(res / norm <= tol || breakdown || j % HPDDM_REPLACEMENT == 0) {
+                        // residual replacement, the recursively updated vectors drift away from the ones they stand for, so convergence is only declared on the true residual
+                        time = History::tic();
+                        if(!excluded)
+                            A.GMV(x, r);
+                        History::toc(History::GMV, time);
+                        Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, r, 1);                                  // r = b - A x
+                        if(breakdown)
+                            std::copy_n(r, n, rt);                                                     // restart with r~ = r
+                        inner<excluded>(n, 1, r, r, dot + 4);
+                        time = History::tic();
+                        MPI_Allreduce(MPI_IN_PLACE, dot + 4, 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                        History::toc(History::REDUCTION, time);
+                        res = std::sqrt(std::real(dot[4]));
+                        if(breakdown)
+                            shadow = res;
+                        if(res / norm > tol) {
+                            std::copy_n(r, n, tmp);
+                            time = History::tic();
+                            A.template apply<excluded>(tmp, rh);                                       // r^ = M r
+                            History::toc(History::APPLY, time);
+                            time = History::tic();
+                            if(!excluded)
+                                A.GMV(rh, w);                                                          // w = A r^
+                            History::toc(History::GMV, time);
+                            std::copy_n(w, n, tmp);
+                            time = History::tic();
+                            A.template apply<excluded>(tmp, wh);                                       // w^ = M w
+                            History::toc(History::APPLY, time);
+                            time = History::tic();
+                            if(!excluded)
+                                A.GMV(wh, t);                                                          // t = A w^
+                            History::toc(History::GMV, time);
+                            if(!breakdown) {
+                                time = History::tic();
+                                if(!excluded)
+                                    A.GMV(ph, s);                                                      // s = A p^
+                                History::toc(History::GMV, time);
+                                std::copy_n(s, n, tmp);
+                                time = History::tic();
+                                A.template apply<excluded>(tmp, sh);                                   // s^ = M s
+                                History::toc(History::APPLY, time);
+                                time = History::tic();
+                                if(!excluded)
+                                    A.GMV(sh, z);                                                      // z = A s^
+                                History::toc(History::GMV, time);
+                            }
+                            inner<excluded>(n, 4, r, rt, dot);
+                            time = History::tic();
+                            MPI_Allreduce(MPI_IN_PLACE, dot, 4, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                            History::toc(History::REDUCTION, time);
+                        }
+                    }
+                    History::iteration(res / norm);
+                    if(verbosity)
+                        std::cout << "BICGSTAB: " << std::setw(3) << j << " " << std::scientific << res << " " <<  norm << " " <<  res / norm << " < " << tol << std::endl;
+                    if(res / norm <= tol)
+                        converged = true;
+                    else {
+                        for(unsigned short k = 0; k < 4; ++k)
+                            dot[k] = conj(dot[k]);                                                     // (r~, r), (r~, w), (r~, s), (r~, z)
+                        if(breakdown) {
+                            start = j + 1;
+                            rho = dot[0];
+                            alpha = rho / dot[1];
+                        }
+                        else {
+                            beta = (alpha / omega) * (dot[0] / rho);
+                            rho = dot[0];
+                            alpha = rho / (dot[1] + beta * dot[2] - beta * omega * dot[3]);
+                        }
+                        ++j;
+                    }
+                }
+            }
+            it = std::min(j, it);
+            if(verbosity) {
+                if(converged)
+                    std::cout << "BICGSTAB converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "BICGSTAB does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
+            }
+            Workspace::release(storage);
+            return 0;
+        }
+        /* Function: MINRES
+         *
+         *  Implements the preconditioned MINRES for Hermitian, possibly indefinite, operators and Hermitian positive definite preconditioners, e.g. <Schwarz> with <Schwarz::Prcndtnr::SY>. Inner products are weighted by the partition of unity of the operator, as in <Iterative method::CG>, and the residual is monitored in the norm induced by the preconditioner.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    b              - Right-hand side.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<bool excluded = false, class Operator, class K>
+        static inline int MINRES(const Operator& A, K* const x, const K* const b,
+                                 index_type& it, typename Wrapper<K>::ul_type tol,
+                                 const MPI_Comm& comm, unsigned short verbosity) {
+            const int n = excluded ? 0 : A.getDof();
+            const typename Wrapper<K>::ul_type* const d = A.getScaling();
+            K* const storage = Workspace::get<K>(8 * n, true);
+            K* r1 = storage;                                                                           // Lanczos vectors, unpreconditioned
+            K* r2 = storage + n;
+            K* y = storage + 2 * n;
+            K* const v = storage + 3 * n;
+            K* w = storage + 4 * n;                                                                    // search directions
+            K* w1 = storage + 5 * n;
+            K* w2 = storage + 6 * n;
+            K* const tmp = storage + 7 * n;
+            if(!excluded) {
+                for(int i = 0; i < n; ++i)
+                    if(std::abs(b[i]) > HPDDM_PEN * HPDDM_EPS)
+                        depenalize(b[i], x[i]);
+                A.GMV(x, r1);
+            }
+            Wrapper<K>::axpby(n, 1.0, b, 1, -1.0, r1, 1);
+            std::copy_n(r1, n, tmp);
+            A.template apply<excluded>(tmp, y);                                                        // y = M r
+            Wrapper<K>::diagv(n, d, r1, tmp);
+            typename Wrapper<K>::ul_type beta = Wrapper<K>::dot(&n, y, &i__1, tmp, &i__1);
+            MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+            beta = std::sqrt(std::abs(beta));
+            const typename Wrapper<K>::ul_type norm = beta;
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+            if(norm < HPDDM_EPS) {
+                it = 0;
+                Workspace::release(storage);
+                return 0;
+            }
+            std::copy_n(r1, n, r2);
+            typename Wrapper<K>::ul_type oldb = 0.0, epsilon = 0.0, dbar = 0.0, phibar = beta, cs = -1.0, sn = 0.0;
+            index_type j = 1;
+            bool converged = false;
+            while(j <= it) {
+                double t = History::tic();
+                Wrapper<K>::axpby(n, 1.0 / beta, y, 1, 0.0, v, 1);
+                History::toc(History::ORTHOGONALIZATION, t);
+                t = History::tic();
+                if(!excluded)
+                    A.GMV(v, y);                                                                       // y = A v
+                History::toc(History::GMV, t);
+                t = History::tic();
+                if(j > 1) {
+                    K scal = -beta / oldb;
+                    Wrapper<K>::axpy(&n, &scal, r1, &i__1, y, &i__1);
+                }
+                Wrapper<K>::diagv(n, d, v, tmp);
+                typename Wrapper<K>::ul_type alpha = Wrapper<K>::dot(&n, y, &i__1, tmp, &i__1);
+                History::toc(History::ORTHOGONALIZATION, t);
+                t = History::tic();
+                MPI_Allreduce(MPI_IN_PLACE, &alpha, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                History::toc(History::REDUCTION, t);
+                K scal = -alpha / beta;
+                Wrapper<K>::axpy(&n, &scal, r2, &i__1, y, &i__1);                                      // y = A v - alpha / beta r2 - beta / oldb r1
+                std::swap(r1, r2);
+                std::swap(r2, y);
+                std::copy_n(r2, n, tmp);
+                t = History::tic();
+                A.template apply<excluded>(tmp, y);                                                    // y = M r2
+                History::toc(History::APPLY, t);
+                Wrapper<K>::diagv(n, d, r2, tmp);
+                oldb = beta;
+                beta = Wrapper<K>::dot(&n, y, &i__1, tmp, &i__1);
+                t = History::tic();
+                MPI_Allreduce(MPI_IN_PLACE, &beta, 1, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, comm);
+                History::toc(History::REDUCTION, t);
+                beta = std::sqrt(std::abs(beta));
+                // QR factorization of the tridiagonal Lanczos matrix by Givens rotations
+                const typename Wrapper<K>::ul_type oldepsilon = epsilon;
+                const typename Wrapper<K>::ul_type delta = cs * dbar + sn * alpha;
+                const typename Wrapper<K>::ul_type gbar = sn * dbar - cs * alpha;
+                epsilon = sn * beta;
+                dbar = -cs * beta;
+                const typename Wrapper<K>::ul_type gamma = std::max(std::sqrt(gbar * gbar + beta * beta), std::numeric_limits<typename Wrapper<K>::ul_type>::min());
+                cs = gbar / gamma;
+                sn = beta / gamma;
+                const typename Wrapper<K>::ul_type phi = cs * phibar;
+                phibar *= sn;
+                t = History::tic();
+                std::swap(w1, w2);
+                std::swap(w2, w);
+                Wrapper<K>::axpby(n, 1.0 / gamma, v, 1, 0.0, w, 1);
+                scal = -oldepsilon / gamma;
+                Wrapper<K>::axpy(&n, &scal, w1, &i__1, w, &i__1);
+                scal = -delta / gamma;
+                Wrapper<K>::axpy(&n, &scal, w2, &i__1, w, &i__1);                                      // w = (v - epsilon w1 - delta w2) / gamma
+                scal = phi;
+                Wrapper<K>::axpy(&n, &scal, w, &i__1, x, &i__1);
+                History::toc(History::ORTHOGONALIZATION, t);
+                const typename Wrapper<K>::ul_type res = std::abs(phibar);
+                History::iteration(res / norm);
+                if(verbosity)
+                    std::cout << "MINRES: " << std::setw(3) << j << " " << std::scientific << res << " " <<  norm << " " <<  res / norm << " < " << tol << std::endl;
+                if(res / norm <= tol) {
+                    converged = true;
+                    break;
+                }
+                ++j;
+            }
+            it = std::min(j, it);
+            if(verbosity) {
+                if(converged)
+                    std::cout << "MINRES converges after " << j << " iteration" << (j > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "MINRES does not converges after " << j - 1 << " iteration" << (j > 2 ? "s" : "") << std::endl;
+            }
+            Workspace::release(storage);
+            return 0;
+        }
+        /* Function: PCG
+         *
+         *  Implements the projected CG method. The classical variant reorthogonalizes each new search direction against a window of previous search directions, and records the loss of orthogonality in <History>, i.e. the largest cosine, in the norm induced by the operator, between the new projected preconditioned residual and the search directions of the window older than the last one. The fused variant uses the Chronopoulos--Gear recurrences on the projected operator, with one more recurrence for the projected preconditioner applied to the search directions, so that its single global reduction per iteration is overlapped with the application of the preconditioner and of the projection <Feti::project> or <Bdd::project>. Its residual is measured after the projection of the preconditioned residual.
+         *
+         * Template Parameters:
+         *    Type           - See <Cg>, <Cg::PIPELINED> is not supported.
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vector.
+         *    f              - Right-hand side.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity.
+         *    window         - Number of previous search directions kept for the reorthogonalization of the classical variant, one for the plain CG recurrence, zero to keep all of them (optional).
+         *    threshold      - If positive, a search direction of the window older than the last one is only used for reorthogonalization if its component in the new search direction, in the norm induced by the operator, is larger than threshold times the one of the last search direction (optional). */
+        template<Cg Type = Cg::CLASSICAL, bool excluded = false, class Operator, class K>
+        static inline int PCG(Operator& A, K* const x, const K* const f,
+                              index_type& it, typename Wrapper<K>::ul_type tol,
+                              const MPI_Comm& comm, unsigned short verbosity,
+                              index_type window = 0, const typename Wrapper<K>::ul_type threshold = 0.0) {
+            static_assert(Type != Cg::PIPELINED, "Unsupported type of projected CG");
+            typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
+            const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
+            const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
+            auto m = A.getScaling();
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+
+            if(Type == Cg::FUSED) {
+                ptr_type storage[8];
+                // storage[0] = r
+                // storage[1] = u = P M r
+                // storage[2] = w = P^T F u
+                // storage[3] = P M w
+                // storage[4] = p
+                // storage[5] = s = P^T F p
+                // storage[6] = q = P M s
+                // storage[7] = lambda, or a copy of u scaled by the partition of unity
+                A.allocateArray(storage);
+                ptr_type const r = storage[0];
+                ptr_type const u = storage[1];
+                ptr_type const w = storage[2];
+                ptr_type const z = storage[3];
+                ptr_type const p = storage[4];
+                ptr_type const s = storage[5];
+                ptr_type const q = storage[6];
+                ptr_type const v = std::is_same<ptr_type, K*>::value ? storage[7] : u;
+                if(std::is_same<ptr_type, K*>::value)
+                    A.template start<excluded>(x + offset, f, nullptr, r);
+                else
+                    A.template start<excluded>(x, f, storage[7], r);
+                if(!excluded)
+                    A.precond(r, u);                                                                       //     u_0 = M r_0
+                A.template project<excluded, 'N'>(u);                                                      //     u_0 = P M r_0
+                if(!excluded)
+                    A.apply(u, w);                                                                         //     w_0 = F u_0
+                A.template project<excluded, 'T'>(w);                                                      //     w_0 = P^T F u_0
+
+                K dir[3];
+                K alpha = K(), gamma = K();
+                typename Wrapper<K>::ul_type resInit = 0.0, res = 0.0;
+                MPI_Request rq;
+                index_type i = 0;
+                while(true) {
+                    if(!excluded) {
+                        diagv(n, m, u, v);
+                        dir[0] = dot(&n, u, &i__1, v, &i__1);
+                        dir[1] = dot(&n, r, &i__1, v, &i__1);                                              // gamma_i = < r_i, u_i >
+                        dir[2] = dot(&n, w, &i__1, v, &i__1);                                              // delta_i = < w_i, u_i >
+                    }
+                    else
+                        std::fill_n(dir, 3, K());
+                    double t = History::tic();
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                    MPI_Iallreduce(MPI_IN_PLACE, dir, 3, Wrapper<K>::mpi_type(), MPI_SUM, comm, &rq);
+#else
+                    MPI_Allreduce(MPI_IN_PLACE, dir, 3, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    rq = MPI_REQUEST_NULL;
+#endif
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
+                    if(!excluded)
+                        A.precond(w, z);                                                                   //     z_i = M w_i
+                    A.template project<excluded, 'N'>(z);                                                  //     z_i = P M w_i
+                    History::toc(History::APPLY, t);
+                    t = History::tic();
+                    MPI_Wait(&rq, MPI_STATUS_IGNORE);
+                    History::toc(History::REDUCTION, t);
+                    res = std::sqrt(std::real(dir[0]));
+                    if(i == 0) {
+                        resInit = res;
+                        if(resInit <= tol)
+                            it = 0;
+                    }
+                    else {
+                        History::iteration(res / resInit);
+                        if(verbosity)
+                            std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << res << " " << resInit << " " << res / resInit << " < " << tol << std::endl;
+                        if(res / resInit <= tol) {
+                            it = i;
+                            break;
+                        }
+                    }
+                    if(i++ == it)
+                        break;
+                    const K beta = (i > 1 ? dir[1] / gamma : K());
+                    alpha = dir[1] / (i > 1 ? dir[2] - beta * dir[1] / alpha : dir[2]);
+                    gamma = dir[1];
+                    if(!excluded) {
+                        // beta_1 = 0, so that p, s, and q need not be initialized
+                        axpby(n, K(1.0), u, beta, p);                                                      //     p_i = u_i + beta_i p_i - 1
+                        axpby(n, K(1.0), w, beta, s);                                                      //     s_i = w_i + beta_i s_i - 1
+                        axpby(n, K(1.0), z, beta, q);                                                      //     q_i = z_i + beta_i q_i - 1
+                        if(std::is_same<ptr_type, K*>::value)
+                            axpy(&n, &alpha, p, &i__1, x + offset, &i__1);
+                        else
+                            axpy(&n, &alpha, p, &i__1, storage[7], &i__1);                                 // l_i + 1 = l_i + alpha_i p_i
+                        const K scal = -alpha;
+                        axpy(&n, &scal, s, &i__1, r, &i__1);                                               // r_i + 1 = r_i - alpha_i s_i
+                        axpy(&n, &scal, q, &i__1, u, &i__1);                                               // u_i + 1 = u_i - alpha_i q_i
+                        t = History::tic();
+                        A.apply(u, w);                                                                     // w_i + 1 = F u_i + 1
+                        History::toc(History::GMV, t);
+                    }
+                    t = History::tic();
+                    A.template project<excluded, 'T'>(w);                                                  // w_i + 1 = P^T F u_i + 1
+                    History::toc(History::APPLY, t);
+                }
+                if(verbosity) {
+                    if(res / resInit <= tol)
+                        std::cout << "CG converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                    else
+                        std::cout << "CG does not converges after " << i - 1 << " iteration" << (i > 2 ? "s" : "") << std::endl;
+                }
+                if(std::is_same<ptr_type, K*>::value)
+                    A.template computeSolution<excluded>(x, f);
+                else
+                    A.template computeSolution<excluded>(x, storage[7]);
+                clean(storage[0]);
+                return 0;
+            }
+
+            ptr_type storage[std::is_same<ptr_type, K*>::value ? 1 : 2];
+            // storage[0] = r
+            // storage[1] = lambda
+            A.allocateArray(storage);
+            if(std::is_same<ptr_type, K*>::value)
+                A.template start<excluded>(x + offset, f, nullptr, storage[0]);
+            else
+                A.template start<excluded>(x, f, storage[1], storage[0]);
+
+            if(window == 0 || window > it)
+                window = it;
+            std::vector<ptr_type> z;
+            z.reserve(window + 1);
+            ptr_type zCurr;
+            A.allocateSingle(zCurr);
+            z.emplace_back(zCurr);
+            if(!excluded)
+                A.precond(storage[0], zCurr);                                                              //     z_0 = M r_0
+
+            typename Wrapper<K>::ul_type resInit;
+            A.template computeDot<excluded>(&resInit, zCurr, zCurr, comm);
+            resInit = std::sqrt(resInit);
+
+            std::vector<ptr_type> p;
+            p.reserve(window + 1);
+            ptr_type pCurr;
+            A.allocateSingle(pCurr);
+            p.emplace_back(pCurr);
+
+            K* alpha = Workspace::get<K>(excluded ? std::max(static_cast<index_type>(2), it) : it + window);
+            typename Wrapper<K>::ul_type* const norm = Workspace::get<typename Wrapper<K>::ul_type>(window);
+            index_type i = 0;
+            typename Wrapper<K>::ul_type resRel = std::numeric_limits<typename Wrapper<K>::ul_type>::max();
+            typename Wrapper<K>::ul_type loss = 0.0;
+            while(i++ < it) {
+                // the last d search directions are kept, z[j] and p[j] store F p_k and p_k, with k = i - 1 - d + j
+                const index_type d = std::min(static_cast<index_type>(i - 1), window);
+                double t = History::tic();
+                if(!excluded) {
+                    A.template project<excluded, 'N'>(zCurr, pCurr);                                       //     p_i = P z_i
+                    History::toc(History::APPLY, t);
+                    t = History::tic();
+                    for(index_type j = 0; j < d; ++j)
+                        alpha[it + j] = dot(&n, z[j], &i__1, pCurr, &i__1);
+                    History::toc(History::ORTHOGONALIZATION, t);
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, alpha + it, d, Wrapper<K>::mpi_type(), MPI_SUM, comm);     // alpha_k = < z_k, p_i >
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
+                    for(index_type j = 0; j < d; ++j)
+                        norm[j] = std::abs(alpha[it + j]) / std::sqrt(std::abs(alpha[i - 1 - d + j]));     // component of p_i along p_k in the F-norm
+                    typename Wrapper<K>::ul_type removed = 0.0;
+                    for(index_type j = 0; j < d; ++j) {
+                        if(j == d - 1 || threshold <= 0.0 || norm[j] > threshold * norm[d - 1]) {
+                            alpha[it + j] /= -alpha[i - 1 - d + j];
+                            axpy(&n, alpha + it + j, p[j], &i__1, pCurr, &i__1);                           //     p_i = p_i - sum < z_k, p_i > / < z_k, p_k > p_k
+                            removed += norm[j] * norm[j];
+                        }
+                    }
+                    History::toc(History::ORTHOGONALIZATION, t);
+                    t = History::tic();
+                    A.apply(pCurr, zCurr);                                                                 //     z_i = F p_i
+                    History::toc(History::GMV, t);
+
+                    A.allocateSingle(zCurr);
+                    if(std::is_same<ptr_type, K*>::value) {
+                        diagv(n, m, pCurr, zCurr);
+                        alpha[i - 1] = dot(&n, z.back(), &i__1, zCurr, &i__1);
+                        alpha[i]     = dot(&n, storage[0], &i__1, zCurr, &i__1);
+                    }
+                    else {
+                        alpha[i - 1] = dot(&n, z.back(), &i__1, pCurr, &i__1);
+                        alpha[i]     = dot(&n, storage[0], &i__1, pCurr, &i__1);
+                    }
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, alpha + i - 1, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    if(d > 1)                                                                              //     < F P z_i, P z_i > = < F p_i, p_i > + sum of the squared removed components
+                        loss = *std::max_element(norm, norm + d - 1) / std::sqrt(std::abs(alpha[i - 1]) + removed);
+                    alpha[it] = alpha[i] / alpha[i - 1];
+                    if(std::is_same<ptr_type, K*>::value)
+                        axpy(&n, alpha + it, pCurr, &i__1, x + offset, &i__1);
+                    else
+                        axpy(&n, alpha + it, pCurr, &i__1, storage[1], &i__1);                             // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
+                    alpha[it] = -alpha[it];
+                    axpy(&n, alpha + it, z.back(), &i__1, storage[0], &i__1);                              // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
+                    t = History::tic();
+                    A.template project<excluded, 'T'>(storage[0]);                                         // r_i + 1 = P^T r_i + 1
 
                     z.emplace_back(zCurr);
                     A.precond(storage[0], zCurr);                                                          // z_i + 1 = M r_i
+                    History::toc(History::APPLY, t);
                 }
                 else {
                     A.template project<excluded, 'N'>(zCurr, pCurr);
-                    std::fill(alpha, alpha + i - 1, 0.0);
-                    MPI_Allreduce(MPI_IN_PLACE, alpha, i - 1, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::APPLY, t);
+                    t = History::tic();
+                    std::fill(alpha, alpha + d, 0.0);
+                    MPI_Allreduce(MPI_IN_PLACE, alpha, d, Wrapper<K>::mpi_type(), MPI_SUM, comm);
                     std::fill(alpha, alpha + 2, 0.0);
                     MPI_Allreduce(MPI_IN_PLACE, alpha, 2, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
                     A.template project<excluded, 'T'>(storage[0]);
+                    History::toc(History::APPLY, t);
                 }
+                t = History::tic();
                 A.template computeDot<excluded>(&resRel, zCurr, zCurr, comm);
+                History::toc(History::REDUCTION, t);
                 resRel = std::sqrt(resRel);
-                if(verbosity)
-                    std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << resRel << " " << resInit << " " << resRel / resInit << " < " << tol << std::endl;
+                History::orthogonality(loss);
+                History::iteration(resRel / resInit);
+                if(verbosity) {
+                    std::cout << "CG: " << std::setw(3) << i << " " << std::scientific << resRel << " " << resInit << " " << resRel / resInit << " < " << tol;
+                    if(verbosity > 1 && window > 1)
+                        std::cout << " (loss of orthogonality: " << loss << ")";
+                    std::cout << std::endl;
+                }
                 if(resRel / resInit <= tol) {
                     it = i;
                     break;
@@ -542,7 +2529,13 @@ class IterativeMethod {
                 if(!excluded) {
                     A.allocateSingle(pCurr);
                     p.emplace_back(pCurr);
-                    diagv(n, m, z[i - 1]);
+                    diagv(n, m, z[z.size() - 2]);
+                    if(p.size() > window + 1U) {
+                        clean(p.front());
+                        p.erase(p.begin());
+                        clean(z.front());
+                        z.erase(z.begin());
+                    }
                 }
             }
             if(verbosity) {
@@ -555,7 +2548,8 @@ class IterativeMethod {
                 A.template computeSolution<excluded>(x, f);
             else
                 A.template computeSolution<excluded>(x, storage[1]);
-            delete [] alpha;
+            Workspace::release(norm);
+            Workspace::release(alpha);
             for(auto zCurr : z)
                 clean(zCurr);
             for(auto pCurr : p)
@@ -563,6 +2557,185 @@ class IterativeMethod {
             clean(storage[0]);
             return 0;
         }
+        /* Function: BPCG
+         *
+         *  Implements the projected CG method for multiple right-hand sides. The recurrences of each right-hand side are independent, but the global operator, the preconditioner, the coarse projections, and the global reductions are applied to all right-hand sides at once. Right-hand sides that have converged are not updated anymore.
+         *
+         * Template Parameters:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    A              - Global operator.
+         *    x              - Solution vectors.
+         *    f              - Right-hand sides.
+         *    mu             - Number of right-hand sides.
+         *    it             - Maximum number of iterations.
+         *    tol            - Tolerance for relative residual decrease.
+         *    comm           - Global MPI communicator.
+         *    verbosity      - Level of verbosity. */
+        template<bool excluded = false, class Operator, class K>
+        static inline int BPCG(Operator& A, K* const x, const K* const f, const unsigned short& mu,
+                               index_type& it, typename Wrapper<K>::ul_type tol,
+                               const MPI_Comm& comm, unsigned short verbosity) {
+            typedef typename std::conditional<std::is_pointer<typename std::remove_reference<decltype(*A.getScaling())>::type>::value, K**, K*>::type ptr_type;
+            const int n = std::is_same<ptr_type, K*>::value ? A.getDof() : A.getMult();
+            const int offset = std::is_same<ptr_type, K*>::value ? A.getEliminated() : 0;
+            const int ld = A.getEliminated() + A.getDof();
+            const unsigned int stride = std::is_same<ptr_type, K*>::value ? n : A.getMap().size();  // distance between two vectors of a block
+            ptr_type r, l = nullptr;
+            A.allocateBlock(r, mu);
+            if(!std::is_same<ptr_type, K*>::value)
+                A.allocateBlock(l, mu);
+            auto m = A.getScaling();
+            A.template start<excluded>(x + offset, f, l, r, mu);
+
+            if(std::abs(tol) < std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon()) {
+                if(verbosity)
+                    std::cout << "WARNING -- the tolerance of the iterative method was set to " << tol << " which is lower than the machine epsilon for type " << demangle(typeid(typename Wrapper<K>::ul_type).name()) << ", forcing the tolerance to " << 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon() << std::endl;
+                tol = 2 * std::numeric_limits<typename Wrapper<K>::ul_type>::epsilon();
+            }
+            std::vector<ptr_type> z;
+            z.reserve(it);
+            ptr_type zCurr;
+            A.allocateBlock(zCurr, mu);
+            z.emplace_back(zCurr);
+            if(!excluded)
+                A.precond(r, zCurr, mu);                                                                   //     z_0 = M r_0
+
+            typename Wrapper<K>::ul_type* const res = Workspace::get<typename Wrapper<K>::ul_type>(2 * mu);
+            typename Wrapper<K>::ul_type* const resInit = res + mu;
+            A.template computeDot<excluded>(resInit, zCurr, zCurr, comm, mu);
+            for(unsigned short nu = 0; nu < mu; ++nu) {
+                resInit[nu] = std::sqrt(resInit[nu]);
+                if(resInit[nu] < HPDDM_EPS)
+                    resInit[nu] = 1.0;
+                res[nu] = std::numeric_limits<typename Wrapper<K>::ul_type>::max();
+            }
+
+            std::vector<ptr_type> p;
+            p.reserve(it);
+            ptr_type pCurr;
+            A.allocateBlock(pCurr, mu);
+            p.emplace_back(pCurr);
+
+            K* const alpha = Workspace::get<K>((it + 1 + std::max(static_cast<index_type>(2), it)) * mu); // alpha[k * mu + nu] = < z_k, p_k > for the nu-th right-hand side
+            K* const beta = alpha + (it + 1) * mu;
+            index_type i = 0;
+            int worst = 0;
+            while(i++ < it) {
+                double t = History::tic();
+                A.template project<excluded, 'N'>(zCurr, pCurr, mu);                                       //     p_i = P z_i
+                History::toc(History::APPLY, t);
+                if(!excluded) {
+                    t = History::tic();
+                    for(index_type k = 0; k < i - 1; ++k)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            beta[k * mu + nu] = dot(&n, z[k] + nu * stride, &i__1, pCurr + nu * stride, &i__1);
+                    History::toc(History::ORTHOGONALIZATION, t);
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, beta, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);  // beta_k = < z_k, p_i >
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
+                    for(index_type k = 0; k < i - 1; ++k)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            if(res[nu] / resInit[nu] > tol) {
+                                beta[k * mu + nu] /= -alpha[k * mu + nu];
+                                axpy(&n, beta + k * mu + nu, p[k] + nu * stride, &i__1, pCurr + nu * stride, &i__1);
+                            }
+                    History::toc(History::ORTHOGONALIZATION, t);
+                    t = History::tic();
+                    A.apply(pCurr, zCurr, mu);                                                             //     z_i = F p_i
+                    History::toc(History::GMV, t);
+
+                    A.allocateBlock(zCurr, mu);
+                    for(unsigned short nu = 0; nu < mu; ++nu) {
+                        if(std::is_same<ptr_type, K*>::value) {
+                            diagv(n, m, pCurr + nu * stride, zCurr + nu * stride);
+                            alpha[(i - 1) * mu + nu] = dot(&n, z.back() + nu * stride, &i__1, zCurr + nu * stride, &i__1);
+                            alpha[i * mu + nu]       = dot(&n, r + nu * stride, &i__1, zCurr + nu * stride, &i__1);
+                        }
+                        else {
+                            alpha[(i - 1) * mu + nu] = dot(&n, z.back() + nu * stride, &i__1, pCurr + nu * stride, &i__1);
+                            alpha[i * mu + nu]       = dot(&n, r + nu * stride, &i__1, pCurr + nu * stride, &i__1);
+                        }
+                    }
+                    t = History::tic();
+                    MPI_Allreduce(MPI_IN_PLACE, alpha + (i - 1) * mu, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    for(unsigned short nu = 0; nu < mu; ++nu) {
+                        if(res[nu] / resInit[nu] > tol) {
+                            beta[nu] = alpha[i * mu + nu] / alpha[(i - 1) * mu + nu];
+                            if(std::is_same<ptr_type, K*>::value)
+                                axpy(&n, beta + nu, pCurr + nu * stride, &i__1, x + nu * ld + offset, &i__1);
+                            else
+                                axpy(&n, beta + nu, pCurr + nu * stride, &i__1, l + nu * stride, &i__1);  // l_i + 1 = l_i + < r_i, p_i > / < z_i, p_i > p_i
+                            beta[nu] = -beta[nu];
+                            axpy(&n, beta + nu, z.back() + nu * stride, &i__1, r + nu * stride, &i__1);   // r_i + 1 = r_i - < r_i, p_i > / < z_i, p_i > z_i
+                        }
+                    }
+                    t = History::tic();
+                    A.template project<excluded, 'T'>(r, nullptr, mu);                                     // r_i + 1 = P^T r_i + 1
+
+                    z.emplace_back(zCurr);
+                    A.precond(r, zCurr, mu);                                                               // z_i + 1 = M r_i
+                    History::toc(History::APPLY, t);
+                }
+                else {
+                    t = History::tic();
+                    std::fill_n(beta, (i - 1) * mu, K());
+                    MPI_Allreduce(MPI_IN_PLACE, beta, (i - 1) * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    std::fill_n(alpha, 2 * mu, K());
+                    MPI_Allreduce(MPI_IN_PLACE, alpha, 2 * mu, Wrapper<K>::mpi_type(), MPI_SUM, comm);
+                    History::toc(History::REDUCTION, t);
+                    t = History::tic();
+                    A.template project<excluded, 'T'>(r, nullptr, mu);
+                    History::toc(History::APPLY, t);
+                }
+                t = History::tic();
+                A.template computeDot<excluded>(res, zCurr, zCurr, comm, mu);
+                History::toc(History::REDUCTION, t);
+                worst = 0;
+                for(unsigned short nu = 0; nu < mu; ++nu) {
+                    res[nu] = std::sqrt(res[nu]);
+                    if(res[nu] / resInit[nu] > res[worst] / resInit[worst])
+                        worst = nu;
+                }
+                History::iteration(res[worst] / resInit[worst]);
+                if(verbosity)
+                    std::cout << "BCG: " << std::setw(3) << i << " " << std::scientific << res[worst] << " " << resInit[worst] << " " << res[worst] / resInit[worst] << " < " << tol << std::endl;
+                if(res[worst] / resInit[worst] <= tol) {
+                    it = i;
+                    break;
+                }
+                if(!excluded) {
+                    A.allocateBlock(pCurr, mu);
+                    p.emplace_back(pCurr);
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        diagv(n, m, z[i - 1] + nu * stride);
+                }
+            }
+            if(verbosity) {
+                if(res[worst] / resInit[worst] <= tol)
+                    std::cout << "BCG converges after " << i << " iteration" << (i > 1 ? "s" : "") << std::endl;
+                else
+                    std::cout << "BCG does not converges after " << i - 1 << " iteration" << (i > 2 ? "s" : "") << std::endl;
+            }
+            if(std::is_same<ptr_type, K*>::value)
+                A.template computeSolution<excluded>(x, f, mu);
+            else
+                A.template computeSolution<excluded>(x, l, mu);
+            Workspace::release(alpha);
+            Workspace::release(res);
+            for(auto zCurr : z)
+                clean(zCurr);
+            for(auto pCurr : p)
+                clean(pCurr);
+            if(!std::is_same<ptr_type, K*>::value)
+                clean(l);
+            clean(r);
+            return 0;
+        }
 };
 } // HPDDM
 #endif // _ITERATIVE_
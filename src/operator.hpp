@@ -29,9 +29,9 @@ namespace HPDDM {
 template<bool> class Members { };
 template<> class Members<true> {
     protected:
-        const unsigned short                             _rank;
-        std::vector<std::vector<unsigned short>>  _vecSparsity;
-        Members(unsigned short r) : _rank(r) { };
+        const index_type                                 _rank;
+        std::vector<std::vector<index_type>>      _vecSparsity;
+        Members(index_type r) : _rank(r) { };
 };
 template<char P, class Preconditioner, class K>
 class OperatorBase : protected Members<P != 's'> {
@@ -39,11 +39,11 @@ class OperatorBase : protected Members<P != 's'> {
         const Preconditioner&                               _p;
         K** const                                   _deflation;
         const vectorNeighbor&                             _map;
-        std::vector<unsigned short>                  _sparsity;
+        std::vector<index_type>                      _sparsity;
         const int                                           _n;
         const int                                       _local;
         unsigned short                                 _signed;
-        unsigned short                           _connectivity;
+        index_type                               _connectivity;
         template<char Q = P, typename std::enable_if<Q == 's'>::type* = nullptr>
         OperatorBase(const Preconditioner& p, const unsigned short& nu) : _p(p), _deflation(p.getVectors()), _map(p.getMap()), _sparsity(), _n(p.getDof()), _local(nu) { }
         template<char Q = P, typename std::enable_if<Q != 's'>::type* = nullptr>
@@ -55,7 +55,7 @@ class OperatorBase : protected Members<P != 's'> {
     public:
         static constexpr char                     _pattern = P;
         template<char Q = P, typename std::enable_if<Q == 's'>::type* = nullptr>
-        inline void sparsity(const unsigned short c) {
+        inline void sparsity(const index_type c) {
             static_assert(Q == P, "Wrong sparsity pattern");
             _connectivity = c;
             _sparsity.reserve(_map.size());
@@ -63,28 +63,28 @@ class OperatorBase : protected Members<P != 's'> {
                 _sparsity.emplace_back(neighbor.first);
         }
         template<char Q = P, typename std::enable_if<Q != 's'>::type* = nullptr>
-        inline void sparsity(const unsigned short c) {
+        inline void sparsity(const index_type c) {
             static_assert(Q == P, "Wrong sparsity pattern");
             _connectivity = c;
             _signed = _p.getSigned();
             if(!_map.empty()) {
-                unsigned short** recvSparsity = new unsigned short*[_map.size() + 1];
-                *recvSparsity = new unsigned short[(_connectivity + 1) * _map.size()];
-                unsigned short* sendSparsity = *recvSparsity + _connectivity * _map.size();
+                index_type** recvSparsity = new index_type*[_map.size() + 1];
+                *recvSparsity = new index_type[(_connectivity + 1) * _map.size()];
+                index_type* sendSparsity = *recvSparsity + _connectivity * _map.size();
                 MPI_Request* rq = new MPI_Request[2 * _map.size()];
                 for(unsigned short i = 0; i < _map.size(); ++i) {
                     sendSparsity[i] = _map[i].first;
                     recvSparsity[i] = *recvSparsity + _connectivity * i;
-                    MPI_Irecv(recvSparsity[i], _connectivity, MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + i);
+                    MPI_Irecv(recvSparsity[i], _connectivity, Wrapper<index_type>::mpi_type(), _map[i].first, 4, _p.getCommunicator(), rq + i);
                 }
                 for(unsigned short i = 0; i < _map.size(); ++i)
-                    MPI_Isend(sendSparsity, _map.size(), MPI_UNSIGNED_SHORT, _map[i].first, 4, _p.getCommunicator(), rq + _map.size() + i);
+                    MPI_Isend(sendSparsity, _map.size(), Wrapper<index_type>::mpi_type(), _map[i].first, 4, _p.getCommunicator(), rq + _map.size() + i);
                 Members<true>::_vecSparsity.resize(_map.size());
                 for(unsigned short i = 0; i < _map.size(); ++i) {
                     int index, count;
                     MPI_Status status;
                     MPI_Waitany(_map.size(), rq, &index, &status);
-                    MPI_Get_count(&status, MPI_UNSIGNED_SHORT, &count);
+                    MPI_Get_count(&status, Wrapper<index_type>::mpi_type(), &count);
                     Members<true>::_vecSparsity[index].assign(recvSparsity[index], recvSparsity[index] + count);
                 }
                 MPI_Waitall(_map.size(), rq + _map.size(), MPI_STATUSES_IGNORE);
@@ -94,14 +94,14 @@ class OperatorBase : protected Members<P != 's'> {
                 delete [] rq;
 
                 _sparsity.reserve(_map.size());
-                std::vector<unsigned short> neighbors;
+                std::vector<index_type> neighbors;
                 neighbors.reserve(_map.size());
                 std::for_each(_map.cbegin(), _map.cend(), [&](const pairNeighbor& n) { neighbors.emplace_back(n.first); });
-                typedef std::pair<std::vector<unsigned short>::const_iterator, std::vector<unsigned short>::const_iterator> pairIt;
+                typedef std::pair<std::vector<index_type>::const_iterator, std::vector<index_type>::const_iterator> pairIt;
                 auto comp = [](const pairIt& lhs, const pairIt& rhs) { return *lhs.first > *rhs.first; };
                 std::priority_queue<pairIt, std::vector<pairIt>, decltype(comp)> pq(comp);
                 pq.push({ neighbors.cbegin(), neighbors.cend() });
-                for(const std::vector<unsigned short>& v : Members<true>::_vecSparsity)
+                for(const std::vector<index_type>& v : Members<true>::_vecSparsity)
                     pq.push({ v.cbegin(), v.cend() });
                 while(!pq.empty()) {
                     pairIt p = pq.top();
@@ -118,19 +118,19 @@ class OperatorBase : protected Members<P != 's'> {
             _connectivity *= _connectivity - 1;
 #else
             _connectivity = _sparsity.size();
-            MPI_Allreduce(MPI_IN_PLACE, &_connectivity, 1, MPI_UNSIGNED_SHORT, MPI_MAX, comm);
+            MPI_Allreduce(MPI_IN_PLACE, &_connectivity, 1, Wrapper<index_type>::mpi_type(), MPI_MAX, comm);
 #endif
         }
-        inline const std::vector<unsigned short>& getPattern() const { return _sparsity; }
-        inline unsigned short getConnectivity() const { return _connectivity; }
+        inline const std::vector<index_type>& getPattern() const { return _sparsity; }
+        inline index_type getConnectivity() const { return _connectivity; }
         template<char S, bool U, class T>
-        inline void initialize(T& in, const unsigned short* info, T const& out, MPI_Request* const& rqRecv, unsigned short*& infoNeighbor) {
+        inline void initialize(T& in, const index_type* info, T const& out, MPI_Request* const& rqRecv, index_type*& infoNeighbor) {
             static_assert(P == 'c', "Unsupported constructor with such a sparsity pattern");
             if(!U) {
-                infoNeighbor = new unsigned short[_map.size()];
-                std::vector<unsigned short>::const_iterator begin = _sparsity.cbegin();
+                infoNeighbor = new index_type[_map.size()];
+                std::vector<index_type>::const_iterator begin = _sparsity.cbegin();
                 for(unsigned short i = 0; i < _map.size(); ++i) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, _sparsity.cend(), _map[i].first);
+                    std::vector<index_type>::const_iterator idx = std::lower_bound(begin, _sparsity.cend(), _map[i].first);
                     infoNeighbor[i] = info[std::distance(_sparsity.cbegin(), idx)];
                     begin = idx + 1;
                 }
@@ -139,19 +139,19 @@ class OperatorBase : protected Members<P != 's'> {
             displs.reserve(2 * _map.size());
             if(S != 'S') {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + _map.size(), _local);
+                    index_type size = std::accumulate(infoNeighbor, infoNeighbor + _map.size(), _local);
                     if(!_map.empty())
                         displs.emplace_back(size * _map[0].second.size());
                     for(unsigned short i = 1; i < _map.size(); ++i)
                         displs.emplace_back(displs.back() + size * _map[i].second.size());
                     for(unsigned short i = 0; i < _map.size(); ++i) {
                         size = infoNeighbor[i];
-                        std::vector<unsigned short>::const_iterator begin = _sparsity.cbegin();
-                        for(const unsigned short& rank : Members<true>::_vecSparsity[i]) {
+                        std::vector<index_type>::const_iterator begin = _sparsity.cbegin();
+                        for(const index_type& rank : Members<true>::_vecSparsity[i]) {
                             if(rank == Members<true>::_rank)
                                 size += _local;
                             else {
-                                std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, _sparsity.cend(), rank);
+                                std::vector<index_type>::const_iterator idx = std::lower_bound(begin, _sparsity.cend(), rank);
                                 size += info[std::distance(_sparsity.cbegin(), idx)];
                                 begin = idx + 1;
                             }
@@ -173,7 +173,7 @@ class OperatorBase : protected Members<P != 's'> {
             }
             else {
                 if(!U) {
-                    unsigned short size = std::accumulate(infoNeighbor, infoNeighbor + _map.size(), 0);
+                    index_type size = std::accumulate(infoNeighbor, infoNeighbor + _map.size(), 0);
                     if(!_map.empty()) {
                         displs.emplace_back((size + _local * (0 < _signed)) * _map[0].second.size());
                         size -= infoNeighbor[0];
@@ -184,9 +184,9 @@ class OperatorBase : protected Members<P != 's'> {
                     }
                     for(unsigned short i = 0; i < _map.size(); ++i) {
                         size = infoNeighbor[i] * !(i < _signed) + _local;
-                        std::vector<unsigned short>::const_iterator end = _sparsity.cend();
-                        for(std::vector<unsigned short>::const_reverse_iterator rit = Members<true>::_vecSparsity[i].rbegin(); *rit > Members<true>::_rank; ++rit) {
-                            std::vector<unsigned short>::const_iterator idx = std::lower_bound(_sparsity.cbegin(), end, *rit);
+                        std::vector<index_type>::const_iterator end = _sparsity.cend();
+                        for(std::vector<index_type>::const_reverse_iterator rit = Members<true>::_vecSparsity[i].rbegin(); *rit > Members<true>::_rank; ++rit) {
+                            std::vector<index_type>::const_iterator idx = std::lower_bound(_sparsity.cbegin(), end, *rit);
                             size += info[std::distance(_sparsity.cbegin(), idx)];
                             end = idx - 1;
                         }
@@ -202,7 +202,7 @@ class OperatorBase : protected Members<P != 's'> {
                     for(unsigned short i = 1; i < _map.size(); ++i)
                         displs.emplace_back(displs.back() + _local * (_map.size() + (i < _signed) - i) * _map[i].second.size());
                     for(unsigned short i = 0; i < _map.size(); ++i) {
-                        unsigned short size = std::distance(std::lower_bound(Members<true>::_vecSparsity[i].cbegin(), Members<true>::_vecSparsity[i].cend(), Members<true>::_rank), Members<true>::_vecSparsity[i].cend()) + !(i < _signed);
+                        index_type size = std::distance(std::lower_bound(Members<true>::_vecSparsity[i].cbegin(), Members<true>::_vecSparsity[i].cend(), Members<true>::_rank), Members<true>::_vecSparsity[i].cend()) + !(i < _signed);
                         displs.emplace_back(displs.back() + _local * size * _map[i].second.size());
                     }
                 }
@@ -236,7 +236,7 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
         const typename Wrapper<K>::ul_type* const       _D;
         K*                                           _work;
         template<char S, bool U>
-        inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* infoNeighbor) {
+        inline void applyFromNeighbor(const K* in, index_type index, K*& work, index_type* infoNeighbor) {
             int m = U ? super::_local : *infoNeighbor;
             std::fill(work, work + m * super::_n, 0.0);
             for(unsigned short i = 0; i < m; ++i)
@@ -247,7 +247,7 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
     public:
         template<template<class> class Solver, char S, class T> friend class CoarseOperator;
         MatrixMultiplication(const Preconditioner& p, const unsigned short& nu) : OperatorBase<'s', Preconditioner, K>(p, nu), _A(p.getMatrix()), _C(), _D(p.getScaling()) { }
-        inline void initialize(unsigned int k, K*& work, unsigned short s) {
+        inline void initialize(unsigned int k, K*& work, index_type s) {
             if(_A->_sym) {
                 std::vector<std::vector<std::pair<unsigned int, K>>> v(_A->_n);
                 unsigned int nnz = std::floor((_A->_nnz + _A->_n - 1) / _A->_n) * 2;
@@ -313,7 +313,7 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
             super::_signed = s;
         }
         template<char S, bool U, class T>
-        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T = nullptr, MPI_Request* = nullptr) {
+        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const index_type* info, T = nullptr, MPI_Request* = nullptr) {
             Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(super::_n), &(super::_local), &(super::_n), &(Wrapper<K>::d__1), false, _C->_a, _C->_ia, _C->_ja, *super::_deflation, &(super::_n), &(Wrapper<K>::d__0), _work, &(super::_n));
             delete _C;
             MPI_Request rq;
@@ -328,21 +328,21 @@ class MatrixMultiplication : public OperatorBase<'s', Preconditioner, K> {
             Wrapper<K>::diagm(super::_n, super::_local, _D, _work, work);
         }
         template<char S, bool U>
-        inline void assembleForMaster(K* C, const K* in, const int& coefficients, unsigned short index, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void assembleForMaster(K* C, const K* in, const int& coefficients, index_type index, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
-            for(unsigned short j = 0; j < (U ? super::_local : *infoNeighbor); ++j) {
+            for(index_type j = 0; j < (U ? super::_local : *infoNeighbor); ++j) {
                 K* pt = C + j;
                 for(unsigned short i = 0; i < super::_local; pt += coefficients - (S == 'S') * i++)
                     *pt = arrayC[j * super::_local + i];
             }
         }
         template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void applyFromNeighborMaster(const K* in, index_type index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
             unsigned int offset = U ? super::_map[index].first * super::_local + (N == 'F') : *offsetJ;
             for(unsigned short i = 0; i < super::_local; ++i) {
                 unsigned int l = coefficients * i - (S == 'S') * (i * (i - 1)) / 2;
-                for(unsigned short j = 0; j < (U ? super::_local : *infoNeighbor); ++j) {
+                for(index_type j = 0; j < (U ? super::_local : *infoNeighbor); ++j) {
 #ifndef HPDDM_CSR_CO
                     I[l + j] = offsetI + i;
 #endif
@@ -359,38 +359,38 @@ template<class Preconditioner, class K>
 class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
     private:
         typedef OperatorBase<'c', Preconditioner, K>                super;
-        std::unordered_map<unsigned short, unsigned int>         _offsets;
-        unsigned short                                       _consolidate;
+        std::unordered_map<index_type, unsigned int>             _offsets;
+        index_type                                           _consolidate;
         template<char S, bool U>
-        inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* info) {
-            std::vector<unsigned short>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), super::_rank);
+        inline void applyFromNeighbor(const K* in, index_type index, K*& work, index_type* info) {
+            std::vector<index_type>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), super::_rank);
             unsigned int accumulate = 0;
             if(!(index < super::_signed)) {
-                for(unsigned short k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k) {
+                for(index_type k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k) {
                     for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                         work[_offsets[super::_map[index].first] + super::_map[index].second[j] + k * super::_n] += in[k * super::_map[index].second.size() + j];
                 }
                 accumulate += (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]) * super::_map[index].second.size();
             }
             else if(S != 'S') {
-                for(unsigned short k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k) {
+                for(index_type k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k) {
                     for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                         work[_offsets[super::_map[index].first] + super::_map[index].second[j] + k * super::_n] -= in[k * super::_map[index].second.size() + j];
                 }
                 accumulate += (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]) * super::_map[index].second.size();
             }
-            std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+            std::vector<index_type>::const_iterator begin = super::_sparsity.cbegin();
             if(S != 'S')
-                for(std::vector<unsigned short>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
+                for(std::vector<index_type>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
                     if(!U) {
-                        std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                        std::vector<index_type>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                         if(*it > super::_map[index].first || super::_signed > index)
-                            for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                            for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                                 for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                                     work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] -= in[accumulate + k * super::_map[index].second.size() + j];
                             }
                         else
-                            for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                            for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                                 for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                                     work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                             }
@@ -422,16 +422,16 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                         work[_offsets[super::_rank] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                 }
             accumulate += super::_local * super::_map[index].second.size();
-            for(std::vector<unsigned short>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
+            for(std::vector<index_type>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
                 if(!U) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                    std::vector<index_type>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
                     if(*it > super::_map[index].first && super::_signed > index)
-                        for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                        for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                             for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                                 work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] -= in[accumulate + k * super::_map[index].second.size() + j];
                         }
                     else
-                        for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                        for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                             for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                                 work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                         }
@@ -461,10 +461,10 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
             if(super::_deflation)
                 std::for_each(super::_deflation, super::_deflation + super::_local, [&](K*& v) { v -= offset; });
         }
-        inline void initialize(unsigned int, K*&, unsigned short) { }
+        inline void initialize(unsigned int, K*&, index_type) { }
         template<char S, bool U, class T>
-        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
-            unsigned short* infoNeighbor;
+        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const index_type* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
+            index_type* infoNeighbor;
             super::template initialize<S, U>(in, info, out, rqRecv, infoNeighbor);
             MPI_Request* rqMult = new MPI_Request[2 * super::_map.size()];
             unsigned int* offset = new unsigned int[super::_map.size() + 2];
@@ -474,7 +474,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 offset[i] = offset[i - 1] + (U ? super::_local : infoNeighbor[i - 2]);
             const int nbMult = super::_p.getMult();
             K* mult = new K[offset[super::_map.size() + 1] * nbMult];
-            unsigned short* accumulator = new unsigned short[super::_map.size() + 1];
+            index_type* accumulator = new index_type[super::_map.size() + 1];
             accumulator[0] = 0;
             for(unsigned short i = 0; i < super::_map.size(); ++i) {
                 MPI_Irecv(mult + offset[i + 1] * nbMult + accumulator[i] * (U ? super::_local : infoNeighbor[i]), super::_map[i].second.size() * (U ? super::_local : infoNeighbor[i]), Wrapper<K>::mpi_type(), super::_map[i].first, 11, super::_p.Subdomain<K>::getCommunicator(), rqMult + i);
@@ -500,11 +500,11 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 int index;
                 MPI_Waitany(super::_map.size(), rqMult, &index, MPI_STATUS_IGNORE);
                 if(index < super::_signed)
-                    for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
+                    for(index_type k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
                         for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                             tmp[super::_map[index].second[j] + (offset[index + 1] + k) * super::_n] = - m[index][j] * mult[offset[index + 1] * nbMult + accumulator[index] * (U ? super::_local : infoNeighbor[index]) + j + k * super::_map[index].second.size()];
                 else
-                    for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
+                    for(index_type k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
                         for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                             tmp[super::_map[index].second[j] + (offset[index + 1] + k) * super::_n] =   m[index][j] * mult[offset[index + 1] * nbMult + accumulator[index] * (U ? super::_local : infoNeighbor[index]) + j + k * super::_map[index].second.size()];
             }
@@ -519,10 +519,10 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
             delete [] mult;
 
             unsigned int accumulate = 0;
-            unsigned short stop = std::distance(super::_sparsity.cbegin(), std::upper_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_rank));
+            index_type stop = std::distance(super::_sparsity.cbegin(), std::upper_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_rank));
             if(S != 'S') {
                 _offsets.reserve(super::_sparsity.size() + 1);
-                for(unsigned short i = 0; i < stop; ++i) {
+                for(index_type i = 0; i < stop; ++i) {
                     _offsets.emplace(super::_sparsity[i], accumulate);
                     accumulate += super::_n * (U ? super::_local : info[i]);
                 }
@@ -531,7 +531,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 _offsets.reserve(super::_sparsity.size() + 1 - stop);
             _offsets.emplace(super::_rank, accumulate);
             accumulate += super::_n * super::_local;
-            for(unsigned short i = stop; i < super::_sparsity.size(); ++i) {
+            for(index_type i = stop; i < super::_sparsity.size(); ++i) {
                 _offsets.emplace(super::_sparsity[i], accumulate);
                 accumulate += super::_n * (U ? super::_local : info[i]);
             }
@@ -545,7 +545,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                     for(unsigned int j = 0; j < super::_map[i].second.size(); ++j)
                         work[_offsets[super::_rank] + super::_map[i].second[j] + k * super::_n] -= (in[i][k * super::_map[i].second.size() + j] = - m[i][j] * tmp[super::_map[i].second[j] + k * super::_n]);
                 for(unsigned short l = (S != 'S' ? 0 : i); l < super::_map.size(); ++l) {
-                    for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
+                    for(index_type k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
                         for(unsigned int j = 0; j < super::_map[i].second.size(); ++j) {
                             if(S != 'S' || !(l < super::_signed))
                                 work[_offsets[super::_map[l].first] + super::_map[i].second[j] + k * super::_n] -= (in[i][(accumulate + k) * super::_map[i].second.size() + j] = - m[i][j] * tmp[super::_map[i].second[j] + (offset[l + 1] + k) * super::_n]);
@@ -573,7 +573,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                             work[_offsets[super::_rank] + super::_map[i].second[j] + k * super::_n] += m[i][j] * tmp[super::_map[i].second[j] + k * super::_n];
                 }
                 for(unsigned short l = S != 'S' ? 0 : super::_signed; l < super::_map.size(); ++l) {
-                    for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
+                    for(index_type k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
                         for(unsigned int j = 0; j < super::_map[i].second.size(); ++j) {
                             if(S != 'S' || !(l < i))
                                 work[_offsets[super::_map[l].first] + super::_map[i].second[j] + k * super::_n] += (in[i][(accumulate + k) * super::_map[i].second.size() + j] =   m[i][j] * tmp[super::_map[i].second[j] + (offset[l + 1] + k) * super::_n]);
@@ -594,7 +594,7 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                 delete [] infoNeighbor;
         }
         template<char S, bool U>
-        inline void assembleForMaster(K* C, const K* in, const int& coefficients, unsigned short index, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void assembleForMaster(K* C, const K* in, const int& coefficients, index_type index, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
             if(++_consolidate == super::_map.size()) {
                 if(S != 'S')
@@ -607,16 +607,16 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
             }
         }
         template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void applyFromNeighborMaster(const K* in, index_type index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             assembleForMaster<S, U>(C, in, coefficients, index, arrayC, infoNeighbor);
             if(_consolidate == super::_map.size()) {
-                unsigned short between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
+                index_type between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
                 unsigned int offset = 0;
                 if(S != 'S')
-                    for(unsigned short k = 0; k < between; ++k)
+                    for(index_type k = 0; k < between; ++k)
                         for(unsigned short i = 0; i < super::_local; ++i) {
                             unsigned int l = offset + coefficients * i;
-                            for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+                            for(index_type j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
 #ifndef HPDDM_CSR_CO
                                 I[l + j] = offsetI + i;
 #endif
@@ -636,10 +636,10 @@ class FetiProjection : public OperatorBase<'c', Preconditioner, K> {
                     }
                 }
                 offset += super::_local;
-                for(unsigned short k = between; k < super::_sparsity.size(); ++k) {
+                for(index_type k = between; k < super::_sparsity.size(); ++k) {
                     for(unsigned short i = 0; i < super::_local; ++i) {
                         unsigned int l = offset + coefficients * i - (S == 'S') * ((i * (i - 1)) / 2);
-                        for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+                        for(index_type j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
 #ifndef HPDDM_CSR_CO
                             I[l + j] = offsetI + i;
 #endif
@@ -658,24 +658,24 @@ template<class Preconditioner, class K>
 class BddProjection : public OperatorBase<'c', Preconditioner, K> {
     private:
         typedef OperatorBase<'c', Preconditioner, K>                super;
-        std::unordered_map<unsigned short, unsigned int>         _offsets;
-        unsigned short                                       _consolidate;
+        std::unordered_map<index_type, unsigned int>             _offsets;
+        index_type                                           _consolidate;
         template<char S, bool U>
-        inline void applyFromNeighbor(const K* in, unsigned short index, K*& work, unsigned short* info) {
-            std::vector<unsigned short>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), super::_rank);
+        inline void applyFromNeighbor(const K* in, index_type index, K*& work, index_type* info) {
+            std::vector<index_type>::const_iterator middle = std::lower_bound(super::_vecSparsity[index].cbegin(), super::_vecSparsity[index].cend(), super::_rank);
             unsigned int accumulate = 0;
             if(S != 'S' || !(index < super::_signed)) {
-                for(unsigned short k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k)
+                for(index_type k = 0; k < (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]); ++k)
                     for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                         work[_offsets[super::_map[index].first] + super::_map[index].second[j] + k * super::_n] += in[k * super::_map[index].second.size() + j];
                 accumulate += (U ? super::_local : info[std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_map[index].first))]) * super::_map[index].second.size();
             }
-            std::vector<unsigned short>::const_iterator begin = super::_sparsity.cbegin();
+            std::vector<index_type>::const_iterator begin = super::_sparsity.cbegin();
             if(S != 'S')
-                for(std::vector<unsigned short>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
+                for(std::vector<index_type>::const_iterator it = super::_vecSparsity[index].cbegin(); it != middle; ++it) {
                     if(!U) {
-                        std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
-                        for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                        std::vector<index_type>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                        for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                             for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                                 work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                         }
@@ -695,10 +695,10 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                     work[_offsets[super::_rank] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
             }
             accumulate += super::_local * super::_map[index].second.size();
-            for(std::vector<unsigned short>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
+            for(std::vector<index_type>::const_iterator it = middle + 1; it != super::_vecSparsity[index].cend(); ++it) {
                 if(!U) {
-                    std::vector<unsigned short>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
-                    for(unsigned short k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
+                    std::vector<index_type>::const_iterator idx = std::lower_bound(begin, super::_sparsity.cend(), *it);
+                    for(index_type k = 0; k < info[std::distance(super::_sparsity.cbegin(), idx)]; ++k) {
                         for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                             work[_offsets[*it] + super::_map[index].second[j] + k * super::_n] += in[accumulate + k * super::_map[index].second.size() + j];
                     }
@@ -722,10 +722,10 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
             if(super::_deflation)
                 std::for_each(super::_deflation, super::_deflation + super::_local, [&](K*& v) { v -= offset; });
         }
-        inline void initialize(unsigned int, K*&, unsigned short) { }
+        inline void initialize(unsigned int, K*&, index_type) { }
         template<char S, bool U, class T>
-        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const unsigned short* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
-            unsigned short* infoNeighbor;
+        inline void applyToNeighbor(T& in, K*& work, std::vector<MPI_Request>& rqSend, const index_type* info, T const& out = nullptr, MPI_Request* const& rqRecv = nullptr) {
+            index_type* infoNeighbor;
             super::template initialize<S, U>(in, info, out, rqRecv, infoNeighbor);
             MPI_Request* rqMult = new MPI_Request[2 * super::_map.size()];
             unsigned int* offset = new unsigned int[super::_map.size() + 2];
@@ -735,7 +735,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                 offset[i] = offset[i - 1] + (U ? super::_local : infoNeighbor[i - 2]);
             const int nbMult = super::_p.getMult();
             K* mult = new K[offset[super::_map.size() + 1] * nbMult];
-            unsigned short* accumulator = new unsigned short[super::_map.size() + 1];
+            index_type* accumulator = new index_type[super::_map.size() + 1];
             accumulator[0] = 0;
             for(unsigned short i = 0; i < super::_map.size(); ++i) {
                 MPI_Irecv(mult + offset[i + 1] * nbMult + accumulator[i] * (U ? super::_local : infoNeighbor[i]), super::_map[i].second.size() * (U ? super::_local : infoNeighbor[i]), Wrapper<K>::mpi_type(), super::_map[i].first, 11, super::_p.Subdomain<K>::getCommunicator(), rqMult + i);
@@ -754,7 +754,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
             for(unsigned short i = 0; i < super::_map.size(); ++i) {
                 int index;
                 MPI_Waitany(super::_map.size(), rqMult, &index, MPI_STATUS_IGNORE);
-                for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
+                for(index_type k = 0; k < (U ? super::_local : infoNeighbor[index]); ++k)
                     for(unsigned int j = 0; j < super::_map[index].second.size(); ++j)
                         tmp[super::_map[index].second[j] + (offset[index + 1] + k) * super::_n] = mult[offset[index + 1] * nbMult + accumulator[index] * (U ? super::_local : infoNeighbor[index]) + j + k * super::_map[index].second.size()];
             }
@@ -769,10 +769,10 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
             delete [] mult;
 
             unsigned int accumulate = 0;
-            unsigned short stop = std::distance(super::_sparsity.cbegin(), std::upper_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_rank));
+            index_type stop = std::distance(super::_sparsity.cbegin(), std::upper_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_rank));
             if(S != 'S') {
                 _offsets.reserve(super::_sparsity.size() + 1);
-                for(unsigned short i = 0; i < stop; ++i) {
+                for(index_type i = 0; i < stop; ++i) {
                     _offsets.emplace(super::_sparsity[i], accumulate);
                     accumulate += super::_n * (U ? super::_local : info[i]);
                 }
@@ -781,7 +781,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                 _offsets.reserve(super::_sparsity.size() + 1 - stop);
             _offsets.emplace(super::_rank, accumulate);
             accumulate += super::_n * super::_local;
-            for(unsigned short i = stop; i < super::_sparsity.size(); ++i) {
+            for(index_type i = stop; i < super::_sparsity.size(); ++i) {
                 _offsets.emplace(super::_sparsity[i], accumulate);
                 accumulate += super::_n * (U ? super::_local : info[i]);
             }
@@ -803,7 +803,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                             work[_offsets[super::_rank] + super::_map[i].second[j] + k * super::_n] = tmp[super::_map[i].second[j] + k * super::_n];
                 }
                 for(unsigned short l = S != 'S' ? 0 : std::min(i, super::_signed); l < super::_map.size(); ++l) {
-                    for(unsigned short k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
+                    for(index_type k = 0; k < (U ? super::_local : infoNeighbor[l]); ++k)
                         for(unsigned int j = 0; j < super::_map[i].second.size(); ++j) {
                             if(S != 'S' || !(l < std::max(i, super::_signed)))
                                 work[_offsets[super::_map[l].first] + super::_map[i].second[j] + k * super::_n] = in[i][(accumulate + k) * super::_map[i].second.size() + j] = tmp[super::_map[i].second[j] + (offset[l + 1] + k) * super::_n];
@@ -828,7 +828,7 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                 delete [] infoNeighbor;
         }
         template<char S, bool U>
-        inline void assembleForMaster(K* C, const K* in, const int& coefficients, unsigned short index, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void assembleForMaster(K* C, const K* in, const int& coefficients, index_type index, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             applyFromNeighbor<S, U>(in, index, arrayC, infoNeighbor);
             if(++_consolidate == super::_map.size()) {
                 const typename Wrapper<K>::ul_type* const m = super::_p.getScaling();
@@ -844,16 +844,16 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
             }
         }
         template<char S, char N, bool U>
-        inline void applyFromNeighborMaster(const K* in, unsigned short index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, unsigned short* const& infoNeighbor = nullptr) {
+        inline void applyFromNeighborMaster(const K* in, index_type index, int* I, int* J, K* C, int coefficients, unsigned int offsetI, unsigned int* offsetJ, K* arrayC, index_type* const& infoNeighbor = nullptr) {
             assembleForMaster<S, U>(C, in, coefficients, index, arrayC, infoNeighbor);
             if(_consolidate == super::_map.size()) {
-                unsigned short between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
+                index_type between = std::distance(super::_sparsity.cbegin(), std::lower_bound(super::_sparsity.cbegin(), super::_sparsity.cend(), super::_p.getRank()));
                 unsigned int offset = 0;
                 if(S != 'S')
-                    for(unsigned short k = 0; k < between; ++k)
+                    for(index_type k = 0; k < between; ++k)
                         for(unsigned short i = 0; i < super::_local; ++i) {
                             unsigned int l = offset + coefficients * i;
-                            for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+                            for(index_type j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
 #ifndef HPDDM_CSR_CO
                                 I[l + j] = offsetI + i;
 #endif
@@ -873,10 +873,10 @@ class BddProjection : public OperatorBase<'c', Preconditioner, K> {
                     }
                 }
                 offset += super::_local;
-                for(unsigned short k = between; k < super::_sparsity.size(); ++k) {
+                for(index_type k = between; k < super::_sparsity.size(); ++k) {
                     for(unsigned short i = 0; i < super::_local; ++i) {
                         unsigned int l = offset + coefficients * i - (S == 'S') * ((i * (i - 1)) / 2);
-                        for(unsigned short j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
+                        for(index_type j = 0; j < (U ? super::_local : infoNeighbor[k]); ++j) {
 #ifndef HPDDM_CSR_CO
                             I[l + j] = offsetI + i;
 #endif
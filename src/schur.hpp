@@ -244,7 +244,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
             MPI_Comm_rank(Subdomain<K>::_communicator, &_rankWorld);
             for(const pairNeighbor& neighbor : Subdomain<K>::_map) {
                 _mult += neighbor.second.size();
-                if(neighbor.first < _rankWorld)
+                if(static_cast<int>(neighbor.first) < _rankWorld)
                     ++_signed;
             }
             if(m) {
@@ -532,20 +532,21 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    n              - Number of input vectors.
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalSchurComplement(K*& in, const int& n) const {
-            K* out = new K[n * Subdomain<K>::_dof]();
+        inline void applyLocalSchurComplement(K* const in, const int& n) const {
+            K* const out = Workspace::get<K>(n * Subdomain<K>::_dof);
             if(!_schur) {
-                K* tmp = new K[n * _bi->_m];
+                std::fill_n(out, n * Subdomain<K>::_dof, K());
+                K* tmp = Workspace::get<K>(n * _bi->_m);
                 Wrapper<K>::template csrmm<Wrapper<K>::I>(&transb, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), tmp, &_bi->_m);
                 super::_s.solve(tmp, n);
                 Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &_bi->_m, &(Wrapper<K>::d__1), false, _bi->_a, _bi->_ia, _bi->_ja, tmp, &_bi->_m, &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
                 Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &_bb->_m, &(Wrapper<K>::d__2), out, &(Subdomain<K>::_dof));
-                delete [] tmp;
+                Workspace::release(tmp);
             }
             else
                 Wrapper<K>::symm("L", "L", &(Subdomain<K>::_dof), &n, &(Wrapper<K>::d__1), _schur, &(Subdomain<K>::_dof), in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
-            delete [] in;
-            in = out;
+            std::copy_n(out, n * Subdomain<K>::_dof, in);
+            Workspace::release(out);
         }
         /* Function: applyLocalSchurComplement
          *
@@ -586,11 +587,11 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    n              - Number of input vectors.
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalLumpedMatrix(K*& in, const int& n) const {
-            K* out = new K[n * Subdomain<K>::_dof];
+        inline void applyLocalLumpedMatrix(K* const in, const int& n) const {
+            K* const out = Workspace::get<K>(n * Subdomain<K>::_dof);
             Wrapper<K>::template csrmm<Wrapper<K>::I>(&transa, &(Subdomain<K>::_dof), &n, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), true, _bb->_a, _bb->_ia, _bb->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
-            delete [] in;
-            in = out;
+            std::copy_n(out, n * Subdomain<K>::_dof, in);
+            Workspace::release(out);
         }
         /* Function: applyLocalLumpedMatrix
          *
@@ -614,7 +615,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          *    n              - Number of input vectors.
          *
          * See also: <Feti::applyLocalPreconditioner(n)>. */
-        inline void applyLocalSuperlumpedMatrix(K*& in, const int& n) const {
+        inline void applyLocalSuperlumpedMatrix(K* const in, const int& n) const {
             for(unsigned int i = 0; i < Subdomain<K>::_dof; ++i) {
                 K d = _bb->_a[_bb->_ia[i + 1] - (Wrapper<K>::I == 'F' ? 2 : 1)];
                 for(int j = 0; j < n; ++j)
@@ -671,7 +672,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
          * See also: <Schwarz::computeError>. */
         inline void computeError(const K* const x, const K* const f, typename Wrapper<K>::ul_type* const storage) const {
             storage[0] = Wrapper<K>::dot(&(Subdomain<K>::_a->_n), f, &i__1, f, &i__1);
-            K* tmp = new K[Subdomain<K>::_a->_n];
+            K* tmp = Workspace::get<K>(Subdomain<K>::_a->_n);
             std::copy(f, f + Subdomain<K>::_a->_n, tmp);
             Subdomain<K>::exchange(tmp + _bi->_m);
             for(unsigned short i = 0; i < Subdomain<K>::_map.size(); ++i)
@@ -687,7 +688,7 @@ class Schur : public Preconditioner<Solver, CoarseOperator, K> {
                         tmp[val] /= (K(1.0) + tmp[val]);
             for(unsigned short i = 0; i < Subdomain<K>::_dof; ++i)
                 storage[1] += std::real(tmp[i]) * std::norm(_work[_bi->_m + i]);
-            delete [] tmp;
+            Workspace::release(tmp);
             MPI_Allreduce(MPI_IN_PLACE, storage, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, Subdomain<K>::_communicator);
             storage[0] = std::sqrt(storage[0]);
             storage[1] = std::sqrt(storage[1]);
@@ -63,6 +63,14 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
 #if HPDDM_GMV
         std::vector<std::pair<std::vector<int>,
                     std::vector<int>>>    _map;
+#endif
+#if HPDDM_SPLITMV
+        /* Variable: rows
+         *  Local rows, those on the interface with neighboring subdomains first. */
+        std::vector<int>                 _rows;
+        /* Variable: interface
+         *  Number of rows on the interface with neighboring subdomains. */
+        unsigned int                _interface;
 #endif
     public:
         Schwarz() : _d() { }
@@ -88,6 +96,21 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                         _map[i].second.emplace_back(k);
                 }
             }
+#endif
+#if HPDDM_SPLITMV
+            std::vector<bool> interface(Subdomain<K>::_dof);
+            for(const auto& i : Subdomain<K>::_map)
+                for(const int& j : i.second)
+                    interface[j] = true;
+            _rows.clear();
+            _rows.reserve(Subdomain<K>::_dof);
+            for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                if(interface[i])
+                    _rows.emplace_back(i);
+            _interface = _rows.size();
+            for(int i = 0; i < Subdomain<K>::_dof; ++i)
+                if(!interface[i])
+                    _rows.emplace_back(i);
 #endif
         }
         /* Function: setType
@@ -207,6 +230,36 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
         inline void deflation(K* const out, const unsigned short& fuse = 0) const {
             deflation<excluded>(nullptr, out, fuse);
         }
+        /* Function: multiDeflation
+         *
+         *  Computes coarse corrections of multiple vectors with a single coarse solve.
+         *
+         * Template parameter:
+         *    excluded       - True if the master processes are excluded from the domain decomposition, false otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        template<bool excluded>
+        inline void multiDeflation(const K* const in, K* const out, const unsigned short& mu) const {
+            K* const uc = Workspace::get<K>(mu * super::_co->getSizeRHS());
+            if(excluded)
+                super::_co->template callSolver<excluded>(uc, 0, mu);
+            else {
+                const int m = mu;
+                Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _d, in, out);                                                                                                                                                     // out = D in
+                Wrapper<K>::gemm(&(Wrapper<K>::transc), &transa, &m, super::getAddrLocal(), &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), out, &(Subdomain<K>::_dof), *super::_ev, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), uc, &m);
+                Wrapper<K>::conjugate(m, super::getLocal(), m, uc);                                                                                                                                                         //  uc = (_ev^T D in)^T
+                super::_co->template callSolver<excluded>(uc, 0, mu);                                                                                                                                                      //  uc = (E \ _ev^T D in)^T
+                Wrapper<K>::gemm(&transa, &transb, &(Subdomain<K>::_dof), &m, super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), uc, &m, &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof)); // out = _ev E \ _ev^T D in
+                if(_type != Prcndtnr::AD) {
+                    Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _d, out, out);
+                    Subdomain<K>::exchange(out, mu);
+                }
+            }
+            Workspace::release(uc);
+        }
         /* Function: buildTwo
          *
          *  Assembles and factorizes the coarse operator by calling <Preconditioner::buildTwo>.
@@ -243,7 +296,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     if(!excluded) {
                         super::_s.solve(in, out);
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
-                        Subdomain<K>::exchange(out);                                                         // out = D A \ in
+                        Subdomain<K>::template exchange<true>(out);                                          // out = D A \ in
                     }
                 }
                 else {
@@ -253,7 +306,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                         super::_s.solve(in, out);
                         if(_type == Prcndtnr::OS)
                             Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
-                        Subdomain<K>::exchange(out);                                                         // out = A \ in
+                        Subdomain<K>::template exchange<true>(out);                                          // out = A \ in
                     }
                 }
             }
@@ -263,12 +316,22 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     MPI_Request rq[2];
                     Ideflation<excluded>(in, out, rq, fuse);
                     if(!excluded) {
-                        super::_s.solve(in);                                                                                                                                                                  // out = A \ in
+                        super::_s.solve(in);                                                                                                                                                                  //  in = A \ in
+#if HPDDM_MIXED
+                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+                        Subdomain<K>::template exchange<true>(in);                                                                                                                                            //  in = D A \ in
+#endif
                         MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
                         Wrapper<K>::gemv(&transa, &(Subdomain<K>::_dof), super::getAddrLocal(), &(Wrapper<K>::d__1), *super::_ev, &(Subdomain<K>::_dof), super::_uc, &i__1, &(Wrapper<K>::d__0), out, &i__1); // out = Z E \ Z^T in
+#if HPDDM_MIXED
+                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                        Subdomain<K>::exchange(out);
+                        Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);                                                                                                  // out = Z E \ Z^T in + D A \ in
+#else
                         Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
                         Subdomain<K>::exchange(out);                                                                                                                                                          // out = Z E \ Z^T in + A \ in
+#endif
                     }
                     else
                         MPI_Wait(rq + 1, MPI_STATUS_IGNORE);
@@ -276,28 +339,103 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     deflation<excluded>(in, out, fuse);
                     if(!excluded) {
                         super::_s.solve(in);
+#if HPDDM_MIXED
+                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
+                        Subdomain<K>::template exchange<true>(in);
+                        Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                        Subdomain<K>::exchange(out);
+                        Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);
+#else
                         Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1);
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
                         Subdomain<K>::exchange(out);
+#endif
                     }
 #endif // HPDDM_ICOLLECTIVE
                 }
                 else {
                     deflation<excluded>(in, out, fuse);                                                      // out = Z E \ Z^T in
                     if(!excluded) {
+#if HPDDM_SPLITMV
+                        splitmv<true>(out, in);                                                              //  in = (I - A Z E \ Z^T) in
+#else
                         Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out, &(Wrapper<K>::d__1), in);
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
                         Subdomain<K>::exchange(in);                                                          //  in = (I - A Z E \ Z^T) in
+#endif
                         if(_type == Prcndtnr::OS)
                             Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
                         super::_s.solve(in);
                         Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in);
-                        Subdomain<K>::exchange(in);                                                          //  in = D A \ (I - A Z E \ Z^T) in
+                        Subdomain<K>::template exchange<true>(in);                                           //  in = D A \ (I - A Z E \ Z^T) in
                         Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__1), in, &i__1, out, &i__1); // out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
                     }
                 }
             }
         }
+        /* Function: apply
+         *
+         *  Applies the global Schwarz preconditioner to multiple vectors.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors.
+         *    work           - Workspace array of size <Subdomain::dof> * mu. */
+        template<bool excluded = false>
+        inline void apply(const K* const in, K* const out, const unsigned short& mu, K* const work) const {
+            const int n = excluded ? 0 : Subdomain<K>::_dof;
+            const int dim = mu * n;
+            if(!super::_co) {
+                if(_type == Prcndtnr::NO)
+                    std::copy_n(in, dim, out);
+                else if(!excluded) {
+                    if(_type == Prcndtnr::OS)
+                        Wrapper<K>::diagm(n, mu, _d, in, out);
+                    else
+                        std::copy_n(in, dim, out);
+                    super::_s.solve(out, mu);
+                    if(_type == Prcndtnr::GE || _type == Prcndtnr::OG)
+                        Wrapper<K>::diagm(n, mu, _d, out, out);
+                    Subdomain<K>::template exchange<true>(out, mu);                                          // out = D A \ in
+                }
+            }
+            else {
+                multiDeflation<excluded>(in, out, mu);                                                       // out = Z E \ Z^T in
+                if(!excluded) {
+                    std::copy_n(in, dim, work);
+                    if(_type == Prcndtnr::AD) {
+                        super::_s.solve(work, mu);
+#if HPDDM_MIXED
+                        Wrapper<K>::diagm(n, mu, _d, work, work);
+                        Subdomain<K>::template exchange<true>(work, mu);                                     // work = D A \ in
+                        Wrapper<K>::diagm(n, mu, _d, out, out);
+                        Subdomain<K>::exchange(out, mu);
+                        Wrapper<K>::axpy(&dim, &(Wrapper<K>::d__1), work, &i__1, out, &i__1);               //  out = Z E \ Z^T in + D A \ in
+#else
+                        Wrapper<K>::axpy(&dim, &(Wrapper<K>::d__1), work, &i__1, out, &i__1);
+                        Wrapper<K>::diagm(n, mu, _d, out, out);
+                        Subdomain<K>::exchange(out, mu);                                                     // out = Z E \ Z^T in + A \ in
+#endif
+                    }
+                    else {
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), &(Wrapper<K>::d__2), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, out + nu * n, &(Wrapper<K>::d__1), work + nu * n);
+                        Wrapper<K>::diagm(n, mu, _d, work, work);
+                        Subdomain<K>::exchange(work, mu);                                                    // work = (I - A Z E \ Z^T) in
+                        if(_type == Prcndtnr::OS)
+                            Wrapper<K>::diagm(n, mu, _d, work, work);
+                        super::_s.solve(work, mu);
+                        Wrapper<K>::diagm(n, mu, _d, work, work);
+                        Subdomain<K>::template exchange<true>(work, mu);                                     // work = D A \ (I - A Z E \ Z^T) in
+                        Wrapper<K>::axpy(&dim, &(Wrapper<K>::d__1), work, &i__1, out, &i__1);               //  out = D A \ (I - A Z E \ Z^T) in + Z E \ Z^T in
+                    }
+                }
+            }
+        }
         /* Function: scaleIntoOverlap
          *
          *  Scales the input matrix using <Schwarz::d> on the overlap and sets the output matrix to zero elsewhere.
@@ -371,9 +509,13 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             const int n = Subdomain<K>::_dof;
             std::for_each(super::_ev, super::_ev + nu, [&](K* const v) { std::replace_if(v, v + n, [](K x) { return std::abs(x) < 1.0 / (HPDDM_EPS * HPDDM_PEN); }, K()); });
         }
-        template<bool sorted = true, bool scale = false>
+        template<bool sorted = true, bool scale = false, bool cache = false>
         inline void interaction(std::vector<const MatrixCSR<K>*>& blocks) const {
-            Subdomain<K>::template interaction<'C', sorted, scale>(blocks, _d);
+            Subdomain<K>::template interaction<'C', sorted, scale, cache>(blocks, _d);
+        }
+        template<bool scale = false>
+        inline void updateInteraction(const std::vector<const MatrixCSR<K>*>& blocks) const {
+            Subdomain<K>::template updateInteraction<'C', scale>(blocks, _d);
         }
 #if HPDDM_GMV
         inline void optimized_exchange(K* const out) const {
@@ -389,6 +531,47 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             }
             MPI_Waitall(Subdomain<K>::_map.size(), Subdomain<K>::_rq + Subdomain<K>::_map.size(), MPI_STATUSES_IGNORE);
         }
+#endif
+#if HPDDM_SPLITMV
+        /* Function: splitmv
+         *
+         *  Computes a local sparse matrix-vector product scaled by <Schwarz::d> and reduces values of duplicated unknowns. For nonsymmetric storage, the rows on the interface are computed first, and the exchange progresses while the interior rows are computed.
+         *
+         * Template Parameter:
+         *    residual       - If set to true, computes out = D (out - A in), otherwise out = D A in.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector. */
+        template<bool residual>
+        inline void splitmv(const K* const in, K* const out) const {
+            const MatrixCSR<K>* const A = Subdomain<K>::_a;
+            if(A->_sym) {
+                Wrapper<K>::template csrmv<'C'>(&transa, &(Subdomain<K>::_dof), &(Subdomain<K>::_dof), residual ? &(Wrapper<K>::d__2) : &(Wrapper<K>::d__1), true, A->_a, A->_ia, A->_ja, in, residual ? &(Wrapper<K>::d__1) : &(Wrapper<K>::d__0), out);
+                Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
+                Subdomain<K>::exchange(out);
+            }
+            else {
+                auto row = [&](const int i) {
+                    K res = K();
+                    for(int j = A->_ia[i]; j < A->_ia[i + 1]; ++j)
+                        res += A->_a[j] * in[A->_ja[j]];
+                    out[i] = _d[i] * (residual ? out[i] - res : res);
+                };
+#pragma omp parallel for schedule(static, HPDDM_GRANULARITY)
+                for(unsigned int i = 0; i < _interface; ++i)
+                    row(_rows[i]);
+                Subdomain<K>::Iexchange(out);
+                for(unsigned int i = _interface; i < _rows.size(); i += HPDDM_GRANULARITY) {
+                    const unsigned int end = std::min(i + HPDDM_GRANULARITY, static_cast<unsigned int>(_rows.size()));
+#pragma omp parallel for
+                    for(unsigned int j = i; j < end; ++j)
+                        row(_rows[j]);
+                    Subdomain<K>::progress();
+                }
+                Subdomain<K>::wait(out);
+            }
+        }
 #endif
         /* Function: GMV
          *
@@ -399,11 +582,13 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          *    out            - Output vector. */
         inline void GMV(const K* const in, K* const out) const {
 #if 0
-            K* tmp = new K[Subdomain<K>::_dof];
+            K* tmp = Workspace::get<K>(Subdomain<K>::_dof);
             Wrapper<K>::diagv(Subdomain<K>::_dof, _d, in, tmp);
             Wrapper<K>::template csrmv<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, tmp, out);
-            delete [] tmp;
+            Workspace::release(tmp);
             Subdomain<K>::exchange(out);
+#elif HPDDM_SPLITMV && !HPDDM_GMV
+            splitmv<false>(in, out);
 #else
             Wrapper<K>::template csrmv<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, out);
 #if HPDDM_GMV
@@ -412,6 +597,29 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             Wrapper<K>::diagv(Subdomain<K>::_dof, _d, out);
             Subdomain<K>::exchange(out);
 #endif
+#endif
+        }
+        /* Function: GMV
+         *
+         *  Computes a global sparse matrix-matrix product.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        inline void GMV(const K* const in, K* const out, const int& mu) const {
+#if HPDDM_MKL
+            for(int nu = 0; nu < mu; ++nu)
+                Wrapper<K>::template csrmv<'C'>(Subdomain<K>::_a->_sym, &(Subdomain<K>::_dof), Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in + nu * Subdomain<K>::_dof, out + nu * Subdomain<K>::_dof);
+#else
+            Wrapper<K>::template csrmm<'C'>(&transa, &(Subdomain<K>::_dof), &mu, &(Subdomain<K>::_dof), &(Wrapper<K>::d__1), Subdomain<K>::_a->_sym, Subdomain<K>::_a->_a, Subdomain<K>::_a->_ia, Subdomain<K>::_a->_ja, in, &(Subdomain<K>::_dof), &(Wrapper<K>::d__0), out, &(Subdomain<K>::_dof));
+#endif
+#if HPDDM_GMV
+            for(int nu = 0; nu < mu; ++nu)
+                optimized_exchange(out + nu * Subdomain<K>::_dof);
+#else
+            Wrapper<K>::diagm(Subdomain<K>::_dof, mu, _d, out, out);
+            Subdomain<K>::exchange(out, mu);
 #endif
         }
         /* Function: computeError
@@ -425,7 +633,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
          *
          * See also: <Schur::computeError>. */
         inline void computeError(const K* const x, const K* const f, typename Wrapper<K>::ul_type* const storage) const {
-            K* tmp = new K[Subdomain<K>::_dof];
+            K* tmp = Workspace::get<K>(Subdomain<K>::_dof);
             GMV(x, tmp);
             Wrapper<K>::axpy(&(Subdomain<K>::_dof), &(Wrapper<K>::d__2), f, &i__1, tmp, &i__1);
             storage[0] = storage[1] = 0.0;
@@ -439,7 +647,7 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
                     storage[1] += _d[i] * std::norm(tmp[i]);
                 }
             }
-            delete [] tmp;
+            Workspace::release(tmp);
             MPI_Allreduce(MPI_IN_PLACE, storage, 2, Wrapper<typename Wrapper<K>::ul_type>::mpi_type(), MPI_SUM, Subdomain<K>::_communicator);
             storage[0] = std::sqrt(storage[0]);
             storage[1] = std::sqrt(storage[1]);
@@ -452,5 +660,99 @@ class Schwarz : public Preconditioner<Solver, CoarseOperator<CoarseSolver, S, K>
             return Subdomain<K>::distributedCSR(num, first, last, ia, ja, c, Subdomain<K>::_a);
         }
 };
+
+/* Class: MixedPrecision
+ *
+ *  A class that pairs a global operator with a Schwarz preconditioner assembled in a lower precision, e.g. a single precision preconditioner for a double precision Krylov method. Vectors are converted at the boundary of <MixedPrecision::apply>, so that local factorizations, deflation vectors and coarse operators are stored in the lower precision.
+ *
+ * Template Parameters:
+ *    Solver         - Solver used for the factorization of local matrices.
+ *    CoarseOperator - Class of the coarse operator.
+ *    S              - 'S'ymmetric or 'G'eneral coarse operator.
+ *    K              - Scalar type of the global operator.
+ *    T              - Scalar type of the preconditioner. */
+template<template<class> class Solver, template<class> class CoarseSolver, char S, class K, class T>
+class MixedPrecision {
+    private:
+        /* Variable: A
+         *  Global operator, only used for matrix-vector products. */
+        const Schwarz<Solver, CoarseSolver, S, K>&         _A;
+        /* Variable: P
+         *  Preconditioner in lower precision. */
+        const Schwarz<Solver, CoarseSolver, S, T>&         _P;
+    public:
+        MixedPrecision(const Schwarz<Solver, CoarseSolver, S, K>& A, const Schwarz<Solver, CoarseSolver, S, T>& P) : _A(A), _P(P) {
+            static_assert(std::is_same<typename Wrapper<K>::ul_type, K>::value == std::is_same<typename Wrapper<T>::ul_type, T>::value, "Wrong types");
+        }
+        MixedPrecision(const MixedPrecision&) = delete;
+        /* Function: getDof
+         *  Returns the number of local degrees of freedom of the global operator. */
+        inline int getDof() const { return _A.getDof(); }
+        /* Function: getScaling
+         *  Returns the local partition of unity of the global operator. */
+        inline const typename Wrapper<K>::ul_type* getScaling() const { return _A.getScaling(); }
+        /* Function: getCommunicator
+         *  Returns the MPI communicator of the global operator. */
+        inline const MPI_Comm& getCommunicator() const { return _A.getCommunicator(); }
+        /* Function: GMV
+         *  Computes a global sparse matrix-vector product with the global operator, see <Schwarz::GMV>. */
+        inline void GMV(const K* const in, K* const out) const {
+            _A.GMV(in, out);
+        }
+        inline void GMV(const K* const in, K* const out, const int& mu) const {
+            _A.GMV(in, out, mu);
+        }
+        /* Function: apply
+         *
+         *  Applies the preconditioner in lower precision.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    in             - Input vector.
+         *    out            - Output vector.
+         *    fuse           - Number of fused reductions (optional), performed in the higher precision while the preconditioner is applied. */
+        template<bool excluded = false>
+        inline void apply(K* const in, K* const out, const unsigned short& fuse = 0) const {
+            const int n = excluded ? 0 : _A.getDof();
+            MPI_Request rq;
+            if(fuse > 0) {
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                MPI_Iallreduce(MPI_IN_PLACE, out + n, fuse, Wrapper<K>::mpi_type(), MPI_SUM, _A.getCommunicator(), &rq);
+#else
+                MPI_Allreduce(MPI_IN_PLACE, out + n, fuse, Wrapper<K>::mpi_type(), MPI_SUM, _A.getCommunicator());
+                rq = MPI_REQUEST_NULL;
+#endif
+            }
+            T* const buffer = Workspace::get<T>(2 * n);
+            std::copy_n(in, n, buffer);
+            _P.template apply<excluded>(buffer, buffer + n);
+            std::copy_n(buffer + n, n, out);
+            Workspace::release(buffer);
+            if(fuse > 0)
+                MPI_Wait(&rq, MPI_STATUS_IGNORE);
+        }
+        /* Function: apply
+         *
+         *  Applies the preconditioner in lower precision to multiple vectors.
+         *
+         * Template Parameter:
+         *    excluded       - Greater than 0 if the master processes are excluded from the domain decomposition, equal to 0 otherwise.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        template<bool excluded = false>
+        inline void apply(const K* const in, K* const out, const unsigned short& mu, K* const) const {
+            const int n = (excluded ? 0 : _A.getDof()) * mu;
+            T* const buffer = Workspace::get<T>(3 * n);
+            std::copy_n(in, n, buffer);
+            _P.template apply<excluded>(buffer, buffer + n, mu, buffer + 2 * n);
+            std::copy_n(buffer + n, n, out);
+            Workspace::release(buffer);
+        }
+};
 } // HPDDM
 #endif // _SCHWARZ_
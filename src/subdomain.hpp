@@ -25,7 +25,9 @@
 #ifndef _SUBDOMAIN_
 #define _SUBDOMAIN_
 
+#include <cassert>
 #include <unordered_map>
+#include <tuple>
 
 namespace HPDDM {
 /* Class: Subdomain
@@ -46,6 +48,33 @@ class Subdomain {
         /* Variable: rq
          *  Array of MPI requests to check completion of the MPI transfers with neighboring subdomains. */
         MPI_Request*                _rq;
+        /* Variable: persistent
+         *  Array of persistent MPI requests for receiving in <Subdomain::rbuff> and sending from <Subdomain::sbuff> values of type K, set once in <Subdomain::initialize>. */
+        MPI_Request*        _persistent;
+#if HPDDM_NEIGHBORHOOD
+        /* Variable: graph
+         *  Distributed graph topology built on top of <Subdomain::communicator> with <Subdomain::map> as adjacency. */
+        MPI_Comm                 _graph;
+        /* Variable: counts
+         *  Number of values exchanged with each neighboring subdomain, followed by the displacements in <Subdomain::rbuff> and <Subdomain::sbuff>. */
+        int*                    _counts;
+        /* Variable: request
+         *  MPI request of the nonblocking neighborhood collective started in <Subdomain::Iexchange>. */
+        mutable MPI_Request    _request;
+#elif HPDDM_SHARED
+        /* Variable: window
+         *  MPI window of memory shared by all processes of the same node. */
+        MPI_Win                 _window;
+        /* Variable: shared
+         *  For each neighboring subdomain on the same node, two pointers in the current process memory where values for the neighbor are written, followed by two pointers in the neighbor memory where values for the current subdomain are read, for even and odd exchanges. Null pointers for other neighboring subdomains. */
+        std::vector<K*>         _shared;
+        /* Variable: sequence
+         *  Pointers to the number of exchanges started by each neighboring subdomain on the same node (null pointers for other neighboring subdomains), followed by the one of the current subdomain. */
+        std::vector<volatile unsigned int*> _sequence;
+        /* Variable: offnode
+         *  Number of neighboring subdomains on other nodes. */
+        unsigned short         _offnode;
+#endif
         /* Variable: communicator
          *  MPI communicator of the subdomain. */
         MPI_Comm          _communicator;
@@ -57,11 +86,56 @@ class Subdomain {
         /* Variable: a
          *  Local matrix. */
         MatrixCSR<K>*                _a;
+        /* Variable: runs
+         *  For each neighboring subdomain, starting indices and lengths of the runs of consecutive unknowns in <Subdomain::map>, or an empty vector if runs are too short to be worth it. */
+        std::vector<std::vector<int>>                                           _runs;
+        /* Variable: plan
+         *  Positions in the local matrix of the values sent to each neighboring subdomain, cached by <Subdomain::interaction>. */
+        mutable std::vector<std::vector<unsigned int>>                          _plan;
+        /* Variable: target
+         *  Index in the output vector of <Subdomain::interaction> of the matrix received from each neighboring subdomain, and positions in that matrix of the received values. */
+        mutable std::vector<std::pair<unsigned short, std::vector<unsigned int>>> _target;
+        /* Variable: block
+         *  Datatypes, persistent MPI requests, and buffers of <Subdomain::transfer>, keyed on the number and size of the values sent per duplicated unknown. */
+        mutable std::unordered_map<unsigned int, std::tuple<MPI_Datatype, MPI_Request*, char*>> _block;
     public:
-        Subdomain() : _rq(), _map(), _a() { }
+#if HPDDM_NEIGHBORHOOD
+        Subdomain() : _rq(), _persistent(), _graph(MPI_COMM_NULL), _counts(), _request(MPI_REQUEST_NULL), _map(), _a() { }
+#elif HPDDM_SHARED
+        Subdomain() : _rq(), _persistent(), _window(MPI_WIN_NULL), _offnode(), _map(), _a() { }
+#else
+        Subdomain() : _rq(), _persistent(), _map(), _a() { }
+#endif
         ~Subdomain() {
             delete _a;
             delete [] _rq;
+            int finalized;
+            MPI_Finalized(&finalized);
+#if HPDDM_NEIGHBORHOOD
+            if(!finalized && _graph != MPI_COMM_NULL)
+                MPI_Comm_free(&_graph);
+            delete [] _counts;
+#elif HPDDM_SHARED
+            if(!finalized && _window != MPI_WIN_NULL) {
+                MPI_Win_unlock_all(_window);
+                MPI_Win_free(&_window);
+            }
+#endif
+            if(!finalized && _persistent)
+                for(unsigned short i = 0; i < 2 * _map.size(); ++i)
+                    MPI_Request_free(_persistent + i);
+            delete [] _persistent;
+            for(const auto& b : _block) {
+                if(!finalized) {
+                    MPI_Datatype type = std::get<0>(b.second);
+                    MPI_Type_free(&type);
+                    if(std::get<1>(b.second))
+                        for(unsigned short i = 0; i < 2 * _map.size(); ++i)
+                            MPI_Request_free(std::get<1>(b.second) + i);
+                }
+                delete [] std::get<1>(b.second);
+                delete [] std::get<2>(b.second);
+            }
             if(!_rbuff.empty())
                 delete [] _rbuff[0];
         }
@@ -71,25 +145,353 @@ class Subdomain {
         /* Function: getMap
          *  Returns a reference to <Subdomain::map>. */
         inline const vectorNeighbor& getMap() const { return _map; }
-        /* Function: exchange
+        /* Function: pack
          *
-         *  Exchanges and reduces values of duplicated unknowns.
+         *  Gathers values of a vector on the interface with a neighboring subdomain, by runs of consecutive unknowns if possible.
+         *
+         * Parameters:
+         *    i              - Index of the neighboring subdomain in <Subdomain::map>.
+         *    in             - Input vector.
+         *    out            - Output buffer. */
+        inline void pack(const unsigned short i, const K* const in, K* out) const {
+            if(_runs[i].empty())
+                Wrapper<K>::gthr(_map[i].second.size(), in, out, _map[i].second.data());
+            else
+                for(unsigned int j = 0; j < _runs[i].size(); j += 2)
+                    out = std::copy_n(in + _runs[i][j], _runs[i][j + 1], out);
+        }
+        /* Function: unpack
+         *
+         *  Adds values received from a neighboring subdomain to a vector, by runs of consecutive unknowns if possible.
+         *
+         * Parameters:
+         *    i              - Index of the neighboring subdomain in <Subdomain::map>.
+         *    in             - Input buffer.
+         *    out            - Output vector. */
+        inline void unpack(const unsigned short i, const K* in, K* const out) const {
+            if(_runs[i].empty())
+                for(unsigned int j = 0; j < _map[i].second.size(); ++j)
+                    out[_map[i].second[j]] += in[j];
+            else
+                for(unsigned int j = 0; j < _runs[i].size(); j += 2) {
+                    K* const pt = out + _runs[i][j];
+                    for(int k = 0; k < _runs[i][j + 1]; ++k)
+                        pt[k] += in[k];
+                    in += _runs[i][j + 1];
+                }
+        }
+        /* Function: Iexchange
+         *
+         *  Starts the exchange of values of duplicated unknowns, which must be completed with <Subdomain::wait>.
+         *
+         * Parameter:
+         *    in             - Input vector, only read on the interface with neighboring subdomains. */
+        inline void Iexchange(const K* const in) const {
+#if HPDDM_NEIGHBORHOOD
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                pack(i, in, _sbuff[i]);
+            MPI_Ineighbor_alltoallv(_sbuff.empty() ? nullptr : _sbuff[0], _counts, _counts + _map.size(), Wrapper<K>::mpi_type(), _rbuff.empty() ? nullptr : _rbuff[0], _counts, _counts + _map.size(), Wrapper<K>::mpi_type(), _graph, &_request);
+#elif HPDDM_SHARED
+            const unsigned int parity = *_sequence.back() % 2;
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                if(_shared[4 * i])
+                    pack(i, in, _shared[4 * i + parity]);
+                else {
+                    MPI_Start(_persistent + i);
+                    pack(i, in, _sbuff[i]);
+                    MPI_Start(_persistent + _map.size() + i);
+                }
+            }
+            MPI_Win_sync(_window);
+            ++*_sequence.back();
+#else
+            MPI_Startall(_map.size(), _persistent);
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                pack(i, in, _sbuff[i]);
+                MPI_Start(_persistent + _map.size() + i);
+            }
+#endif
+        }
+        /* Function: progress
+         *  Lets the MPI library progress the exchange started in <Subdomain::Iexchange>, which is completed only if all pending messages have been transferred. */
+        inline void progress() const {
+            int flag;
+#if HPDDM_NEIGHBORHOOD
+            MPI_Test(&_request, &flag, MPI_STATUS_IGNORE);
+#else
+            if(!_map.empty())
+                MPI_Testall(2 * _map.size(), _persistent, &flag, MPI_STATUSES_IGNORE);
+#endif
+        }
+        /* Function: wait
+         *
+         *  Completes the exchange started in <Subdomain::Iexchange> and reduces values of duplicated unknowns.
          *
          * Parameter:
          *    in             - Input vector. */
-        inline void exchange(K* const in) const {
+        inline void wait(K* const in) const {
+#if HPDDM_NEIGHBORHOOD
+            MPI_Wait(&_request, MPI_STATUS_IGNORE);
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                unpack(i, _rbuff[i], in);
+#elif HPDDM_SHARED
+            const unsigned int sequence = *_sequence.back();
             for(unsigned short i = 0; i < _map.size(); ++i) {
-                MPI_Irecv(_rbuff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
-                Wrapper<K>::gthr(_map[i].second.size(), in, _sbuff[i], _map[i].second.data());
-                MPI_Isend(_sbuff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + _map.size() + i);
+                if(_shared[4 * i]) {
+                    while(*_sequence[i] < sequence)
+                        MPI_Win_sync(_window);
+                    MPI_Win_sync(_window);
+                    unpack(i, _shared[4 * i + 2 + (sequence - 1) % 2], in);
+                }
             }
+            for(unsigned short i = 0; i < _offnode; ++i) {
+                int index;
+                MPI_Waitany(_map.size(), _persistent, &index, MPI_STATUS_IGNORE);
+                if(index == MPI_UNDEFINED) { // all messages have already been received in <Subdomain::progress>
+                    for(unsigned short j = 0; j < _map.size(); ++j)
+                        if(!_shared[4 * j])
+                            unpack(j, _rbuff[j], in);
+                    break;
+                }
+                unpack(index, _rbuff[index], in);
+            }
+            MPI_Waitall(_map.size(), _persistent + _map.size(), MPI_STATUSES_IGNORE);
+#else
             for(unsigned short i = 0; i < _map.size(); ++i) {
                 int index;
-                MPI_Waitany(_map.size(), _rq, &index, MPI_STATUS_IGNORE);
-                for(unsigned int j = 0; j < _map[index].second.size(); ++j)
-                    in[_map[index].second[j]] += _rbuff[index][j];
+                MPI_Waitany(_map.size(), _persistent, &index, MPI_STATUS_IGNORE);
+                if(index == MPI_UNDEFINED) {
+                    for(unsigned short j = 0; j < _map.size(); ++j)
+                        unpack(j, _rbuff[j], in);
+                    break;
+                }
+                unpack(index, _rbuff[index], in);
             }
-            MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
+            MPI_Waitall(_map.size(), _persistent + _map.size(), MPI_STATUSES_IGNORE);
+#endif
+        }
+        /* Function: downscale
+         *  Converts a scalar to the reduced precision used in <Subdomain::exchange>, i.e., single precision or 16-bit truncated floating-point numbers with round-to-nearest-even. */
+        template<class T>
+        static inline void downscale(const K& in, T* const out) {
+            *out = T(in);
+        }
+        static inline void downscale(const K& in, unsigned short* const out) {
+            for(unsigned short i = 0; i < sizeof(K) / sizeof(typename Wrapper<K>::ul_type); ++i) {
+                const float value = reinterpret_cast<const typename Wrapper<K>::ul_type*>(&in)[i];
+                unsigned int bits;
+                std::memcpy(&bits, &value, sizeof(float));
+                out[i] = (bits + 0x7FFF + ((bits >> 16) & 1)) >> 16;
+            }
+        }
+        /* Function: upscale
+         *  Adds a scalar received in reduced precision to a scalar of type K. */
+        template<class T>
+        static inline void upscale(const T* const in, K& out) {
+            out += K(*in);
+        }
+        static inline void upscale(const unsigned short* const in, K& out) {
+            for(unsigned short i = 0; i < sizeof(K) / sizeof(typename Wrapper<K>::ul_type); ++i) {
+                const unsigned int bits = static_cast<unsigned int>(in[i]) << 16;
+                float value;
+                std::memcpy(&value, &bits, sizeof(float));
+                reinterpret_cast<typename Wrapper<K>::ul_type*>(&out)[i] += value;
+            }
+        }
+        /* Function: pack(n)
+         *
+         *  Gathers values of multiple vectors on the interface with a neighboring subdomain, interleaved and converted with <Subdomain::downscale>, by runs of consecutive unknowns if possible.
+         *
+         * Template Parameter:
+         *    T              - Type of the values in the output buffer.
+         *
+         * Parameters:
+         *    i              - Index of the neighboring subdomain in <Subdomain::map>.
+         *    in             - Input vectors.
+         *    out            - Output buffer.
+         *    mu             - Number of vectors. */
+        template<class T>
+        inline void pack(const unsigned short i, const K* const in, T* out, const unsigned short& mu) const {
+            constexpr unsigned short m = std::is_same<T, unsigned short>::value ? sizeof(K) / sizeof(typename Wrapper<K>::ul_type) : 1;
+            if(_runs[i].empty())
+                for(unsigned int j = 0; j < _map[i].second.size(); ++j, out += m * mu)
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        downscale(in[nu * _dof + _map[i].second[j]], out + m * nu);
+            else
+                for(unsigned int j = 0; j < _runs[i].size(); j += 2)
+                    for(int k = _runs[i][j]; k < _runs[i][j] + _runs[i][j + 1]; ++k, out += m * mu)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            downscale(in[nu * _dof + k], out + m * nu);
+        }
+        /* Function: unpack(n)
+         *
+         *  Adds values of multiple vectors received from a neighboring subdomain, interleaved and converted with <Subdomain::upscale>, by runs of consecutive unknowns if possible.
+         *
+         * Template Parameter:
+         *    T              - Type of the values in the input buffer.
+         *
+         * Parameters:
+         *    i              - Index of the neighboring subdomain in <Subdomain::map>.
+         *    in             - Input buffer.
+         *    out            - Output vectors.
+         *    mu             - Number of vectors. */
+        template<class T>
+        inline void unpack(const unsigned short i, const T* in, K* const out, const unsigned short& mu) const {
+            constexpr unsigned short m = std::is_same<T, unsigned short>::value ? sizeof(K) / sizeof(typename Wrapper<K>::ul_type) : 1;
+            if(_runs[i].empty())
+                for(unsigned int j = 0; j < _map[i].second.size(); ++j, in += m * mu)
+                    for(unsigned short nu = 0; nu < mu; ++nu)
+                        upscale(in + m * nu, out[nu * _dof + _map[i].second[j]]);
+            else
+                for(unsigned int j = 0; j < _runs[i].size(); j += 2)
+                    for(int k = _runs[i][j]; k < _runs[i][j] + _runs[i][j + 1]; ++k, in += m * mu)
+                        for(unsigned short nu = 0; nu < mu; ++nu)
+                            upscale(in + m * nu, out[nu * _dof + k]);
+        }
+        /* Function: block
+         *
+         *  Returns the datatype, and except with <HPDDM_NEIGHBORHOOD> the persistent requests and buffers, of <Subdomain::transfer>, which are created on first use.
+         *
+         * Template Parameter:
+         *    T              - Type of the exchanged values.
+         *
+         * Parameter:
+         *    w              - Number of values per duplicated unknown. */
+        template<class T>
+        inline const std::tuple<MPI_Datatype, MPI_Request*, char*>& block(const unsigned short& w) const {
+            const unsigned int key = 32 * w + sizeof(T);
+            auto it = _block.find(key);
+            if(it == _block.cend()) {
+                std::tuple<MPI_Datatype, MPI_Request*, char*> b(MPI_DATATYPE_NULL, nullptr, nullptr);
+                MPI_Type_contiguous(w, Wrapper<T>::mpi_type(), &std::get<0>(b));
+                MPI_Type_commit(&std::get<0>(b));
+#if !HPDDM_NEIGHBORHOOD
+                const unsigned int size = _rbuff.empty() ? 0 : std::distance(_rbuff[0], _sbuff[0]);
+                T* const rbuff = reinterpret_cast<T*>(std::get<2>(b) = new char[2 * w * size * sizeof(T)]);
+                std::get<1>(b) = new MPI_Request[2 * _map.size()];
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    const unsigned int displ = w * std::distance(_rbuff[0], _rbuff[i]);
+                    MPI_Recv_init(rbuff + displ, _map[i].second.size(), std::get<0>(b), _map[i].first, 2, _communicator, std::get<1>(b) + i);
+                    MPI_Send_init(rbuff + w * size + displ, _map[i].second.size(), std::get<0>(b), _map[i].first, 2, _communicator, std::get<1>(b) + _map.size() + i);
+                }
+#endif
+                it = _block.emplace(key, b).first;
+            }
+            return it->second;
+        }
+        /* Function: transfer
+         *
+         *  Exchanges w values of type T per duplicated unknown with all neighboring subdomains, through the same backend as <Subdomain::Iexchange>. Values are written to the shared memory window only if they fit in the space of a single scalar of type K per duplicated unknown, otherwise all neighboring subdomains are reached with messages.
+         *
+         * Template Parameter:
+         *    T              - Type of the exchanged values.
+         *
+         * Parameters:
+         *    w              - Number of values per duplicated unknown.
+         *    pack           - Function filling the sending buffer of a neighboring subdomain.
+         *    unpack         - Function reading the receiving buffer of a neighboring subdomain. */
+        template<class T, class Pack, class Unpack>
+        inline void transfer(const unsigned short& w, const Pack& pack, const Unpack& unpack) const {
+            const std::tuple<MPI_Datatype, MPI_Request*, char*>& b = block<T>(w);
+            const unsigned int size = _rbuff.empty() ? 0 : std::distance(_rbuff[0], _sbuff[0]);
+#if HPDDM_NEIGHBORHOOD
+            T* const rbuff = Workspace::get<T>(2 * w * size);
+            T* const sbuff = rbuff + w * size;
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                pack(i, sbuff + w * std::distance(_rbuff[0], _rbuff[i]));
+            MPI_Neighbor_alltoallv(sbuff, _counts, _counts + _map.size(), std::get<0>(b), rbuff, _counts, _counts + _map.size(), std::get<0>(b), _graph);
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                unpack(i, rbuff + w * std::distance(_rbuff[0], _rbuff[i]));
+            Workspace::release(rbuff);
+#else
+            MPI_Request* const rq = std::get<1>(b);
+            T* const rbuff = reinterpret_cast<T*>(std::get<2>(b));
+            T* const sbuff = rbuff + w * size;
+#if HPDDM_SHARED
+            const bool window = w * sizeof(T) <= sizeof(K);
+            const unsigned int parity = *_sequence.back() % 2;
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                if(window && _shared[4 * i])
+                    pack(i, reinterpret_cast<T*>(_shared[4 * i + parity]));
+                else {
+                    MPI_Start(rq + i);
+                    pack(i, sbuff + w * std::distance(_rbuff[0], _rbuff[i]));
+                    MPI_Start(rq + _map.size() + i);
+                }
+            }
+            if(window) {
+                MPI_Win_sync(_window);
+                const unsigned int sequence = ++*_sequence.back();
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    if(_shared[4 * i]) {
+                        while(*_sequence[i] < sequence)
+                            MPI_Win_sync(_window);
+                        MPI_Win_sync(_window);
+                        unpack(i, reinterpret_cast<const T*>(_shared[4 * i + 2 + (sequence - 1) % 2]));
+                    }
+                }
+            }
+            for(unsigned short i = 0; i < (window ? _offnode : _map.size()); ++i) {
+#else
+            MPI_Startall(_map.size(), rq);
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                pack(i, sbuff + w * std::distance(_rbuff[0], _rbuff[i]));
+                MPI_Start(rq + _map.size() + i);
+            }
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+#endif
+                int index;
+                MPI_Waitany(_map.size(), rq, &index, MPI_STATUS_IGNORE);
+                unpack(index, rbuff + w * std::distance(_rbuff[0], _rbuff[index]));
+            }
+            MPI_Waitall(_map.size(), rq + _map.size(), MPI_STATUSES_IGNORE);
+#endif
+        }
+        /* Function: exchange
+         *
+         *  Exchanges and reduces values of duplicated unknowns.
+         *
+         * Template Parameter:
+         *    mixed          - If set to true and <HPDDM_MIXED> is not set to zero, values are sent in reduced precision.
+         *
+         * Parameter:
+         *    in             - Input vector. */
+        template<bool mixed = false>
+        inline void exchange(K* const in) const {
+#if HPDDM_MIXED
+            typedef typename std::conditional<HPDDM_MIXED == 1, downscaled_type<K>, unsigned short>::type T;
+            if(mixed && !std::is_same<T, K>::value) {
+                constexpr unsigned short m = HPDDM_MIXED == 1 ? 1 : sizeof(K) / sizeof(typename Wrapper<K>::ul_type);
+                transfer<T>(m, [&](const unsigned short i, T* const out) { pack(i, in, out, 1); }, [&](const unsigned short i, const T* const recv) { unpack(i, recv, in, 1); });
+                return;
+            }
+#endif
+            Iexchange(in);
+            wait(in);
+        }
+        /* Function: exchange
+         *
+         *  Exchanges and reduces values of duplicated unknowns of multiple vectors. A single message is sent to each neighboring subdomain, with values of all vectors interleaved.
+         *
+         * Template Parameter:
+         *    mixed          - If set to true and <HPDDM_MIXED> is not set to zero, values are sent in reduced precision.
+         *
+         * Parameters:
+         *    in             - Input vectors.
+         *    mu             - Number of vectors. */
+        template<bool mixed = false>
+        inline void exchange(K* const in, const unsigned short& mu) const {
+            if(mu == 1) {
+                exchange<mixed>(in);
+                return;
+            }
+#if HPDDM_MIXED
+            typedef typename std::conditional<mixed, typename std::conditional<HPDDM_MIXED == 1, downscaled_type<K>, unsigned short>::type, K>::type T;
+#else
+            typedef K T;
+#endif
+            constexpr unsigned short m = std::is_same<T, unsigned short>::value ? sizeof(K) / sizeof(typename Wrapper<K>::ul_type) : 1;
+            transfer<T>(m * mu, [&](const unsigned short i, T* const out) { pack(i, in, out, mu); }, [&](const unsigned short i, const T* const recv) { unpack(i, recv, in, mu); });
         }
         /* Function: recvBuffer
          *
@@ -98,16 +500,22 @@ class Subdomain {
          * Parameter:
          *    in             - Input vector. */
         inline void recvBuffer(const K* const in) const {
+#if HPDDM_NEIGHBORHOOD
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                pack(i, in, _sbuff[i]);
+            MPI_Neighbor_alltoallv(_sbuff.empty() ? nullptr : _sbuff[0], _counts, _counts + _map.size(), Wrapper<K>::mpi_type(), _rbuff.empty() ? nullptr : _rbuff[0], _counts, _counts + _map.size(), Wrapper<K>::mpi_type(), _graph);
+#else
+            MPI_Startall(_map.size(), _persistent);
             for(unsigned short i = 0; i < _map.size(); ++i) {
-                MPI_Irecv(_rbuff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + i);
-                Wrapper<K>::gthr(_map[i].second.size(), in, _sbuff[i], _map[i].second.data());
-                MPI_Isend(_sbuff[i], _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _rq + _map.size() + i);
+                pack(i, in, _sbuff[i]);
+                MPI_Start(_persistent + _map.size() + i);
             }
-            MPI_Waitall(2 * _map.size(), _rq, MPI_STATUSES_IGNORE);
+            MPI_Waitall(2 * _map.size(), _persistent, MPI_STATUSES_IGNORE);
+#endif
         }
         /* Function: initialize
          *
-         *  Initializes all buffers for point-to-point communications and set internal pointers to user-defined values.
+         *  Initializes all buffers, persistent requests, and if needed the distributed graph topology or the shared memory window for neighbor communications and set internal pointers to user-defined values.
          *
          * Parameters:
          *    a              - Local matrix.
@@ -145,6 +553,92 @@ class Subdomain {
                     size += i.second.size();
                 }
             }
+            _runs.assign(_map.size(), std::vector<int>());
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                for(unsigned int j = 0; j < _map[i].second.size(); ++j) {
+                    if(j == 0 || _map[i].second[j] != _map[i].second[j - 1] + 1) {
+                        _runs[i].emplace_back(_map[i].second[j]);
+                        _runs[i].emplace_back(1);
+                    }
+                    else
+                        ++_runs[i].back();
+                }
+                if(HPDDM_RUN * _runs[i].size() > 2 * _map[i].second.size())
+                    std::vector<int>().swap(_runs[i]);
+            }
+#if HPDDM_NEIGHBORHOOD
+            _counts = new int[2 * _map.size()];
+            size = 0;
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                _counts[i] = _map[i].second.size();
+                _counts[_map.size() + i] = size;
+                size += _counts[i];
+            }
+            std::vector<int> neighbors;
+            neighbors.reserve(_map.size());
+            for(const auto& i : _map)
+                neighbors.emplace_back(i.first);
+            MPI_Dist_graph_create_adjacent(_communicator, _map.size(), neighbors.data(), _counts, _map.size(), neighbors.data(), _counts, MPI_INFO_NULL, 1, &_graph);
+#else
+            _persistent = new MPI_Request[2 * _map.size()];
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                MPI_Recv_init(size ? _rbuff[i] : nullptr, _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _persistent + i);
+                MPI_Send_init(size ? _sbuff[i] : nullptr, _map[i].second.size(), Wrapper<K>::mpi_type(), _map[i].first, 0, _communicator, _persistent + _map.size() + i);
+            }
+#if HPDDM_SHARED
+            MPI_Comm node;
+            MPI_Comm_split_type(_communicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+            MPI_Info info;
+            MPI_Info_create(&info);
+            MPI_Info_set(info, "alloc_shared_noncontig", "true");
+            char* base;
+            MPI_Win_allocate_shared(HPDDM_ALIGN + 2 * size * sizeof(K), 1, info, node, &base, &_window);
+            MPI_Info_free(&info);
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+            std::vector<int> ranks(2 * _map.size());
+            for(unsigned short i = 0; i < _map.size(); ++i)
+                ranks[i] = _map[i].first;
+            MPI_Group world, local;
+            MPI_Comm_group(_communicator, &world);
+            MPI_Comm_group(node, &local);
+            MPI_Group_translate_ranks(world, _map.size(), ranks.data(), local, ranks.data() + _map.size());
+            MPI_Group_free(&local);
+            MPI_Group_free(&world);
+            std::vector<unsigned int> offsets(4 * _map.size());
+            _shared.assign(4 * _map.size(), nullptr);
+            _sequence.assign(_map.size() + 1, nullptr);
+            _sequence.back() = reinterpret_cast<unsigned int*>(base);
+            *_sequence.back() = 0;
+            _offnode = 0;
+            for(unsigned short i = 0, displ = 0; i < _map.size(); displ += _map[i++].second.size()) {
+                offsets[2 * i] = size;
+                offsets[2 * i + 1] = displ;
+                MPI_Irecv(offsets.data() + 2 * (_map.size() + i), 2, MPI_UNSIGNED, _map[i].first, 0, _communicator, _rq + i);
+                MPI_Isend(offsets.data() + 2 * i, 2, MPI_UNSIGNED, _map[i].first, 0, _communicator, _rq + _map.size() + i);
+                if(ranks[_map.size() + i] != MPI_UNDEFINED) {
+                    _shared[4 * i] = reinterpret_cast<K*>(base + HPDDM_ALIGN) + displ;
+                    _shared[4 * i + 1] = _shared[4 * i] + size;
+                }
+                else
+                    ++_offnode;
+            }
+            MPI_Waitall(2 * _map.size(), _rq, MPI_STATUSES_IGNORE);
+            for(unsigned short i = 0; i < _map.size(); ++i) {
+                if(_shared[4 * i]) {
+                    MPI_Aint bytes;
+                    int unit;
+                    char* neighbor;
+                    MPI_Win_shared_query(_window, ranks[_map.size() + i], &bytes, &unit, &neighbor);
+                    _sequence[i] = reinterpret_cast<unsigned int*>(neighbor);
+                    _shared[4 * i + 2] = reinterpret_cast<K*>(neighbor + HPDDM_ALIGN) + offsets[2 * (_map.size() + i) + 1];
+                    _shared[4 * i + 3] = _shared[4 * i + 2] + offsets[2 * (_map.size() + i)];
+                }
+            }
+            MPI_Win_sync(_window);
+            MPI_Barrier(node);
+            MPI_Comm_free(&node);
+#endif
+#endif
         }
         /* Function: initialize(dummy)
          *  Dummy function for masters excluded from the domain decomposition. */
@@ -153,6 +647,18 @@ class Subdomain {
                 _communicator = *comm;
             else
                 _communicator = MPI_COMM_WORLD;
+#if HPDDM_NEIGHBORHOOD
+            int weight = 0;
+            MPI_Dist_graph_create_adjacent(_communicator, 0, nullptr, &weight, 0, nullptr, &weight, MPI_INFO_NULL, 1, &_graph);
+#elif HPDDM_SHARED
+            MPI_Comm node;
+            MPI_Comm_split_type(_communicator, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node);
+            char* base;
+            MPI_Win_allocate_shared(HPDDM_ALIGN, 1, MPI_INFO_NULL, node, &base, &_window);
+            MPI_Win_lock_all(MPI_MODE_NOCHECK, _window);
+            MPI_Barrier(node);
+            MPI_Comm_free(&node);
+#endif
         }
         /* Function: exclusion
          *
@@ -179,12 +685,13 @@ class Subdomain {
          *    N              - 0- or 1-based indexing of the input matrix.
          *    sorted         - True if the column indices of each matrix in the vector must be sorted.
          *    scale          - True if the matrices must be scaled by the neighboring partition of unity.
+         *    cache          - True if the communication pattern must be saved for subsequent calls to <Subdomain::updateInteraction>.
          *
          * Parameters:
          *    v              - Output vector.
          *    scaling        - Local partition of unity.
          *    pt             - Pointer to a <MatrixCSR>. */
-        template<char N, bool sorted = true, bool scale = false>
+        template<char N, bool sorted = true, bool scale = false, bool cache = false>
         inline void interaction(std::vector<const MatrixCSR<K>*>& v, const typename Wrapper<K>::ul_type* const scaling = nullptr, const MatrixCSR<K, N>* const pt = nullptr) const {
             const MatrixCSR<K, N>& ref = pt ? *pt : *_a;
             if(ref._n != _dof || ref._m != _dof)
@@ -194,6 +701,10 @@ class Subdomain {
             unsigned int* recvSize = sendSize + 2 * _map.size();
             for(unsigned short k = 0; k < _map.size(); ++k)
                 MPI_Irecv(recvSize + 2 * k, 2, MPI_UNSIGNED, _map[k].first, 10, _communicator, _rq + k);
+            if(cache) {
+                _plan.assign(_map.size(), std::vector<unsigned int>());
+                _target.assign(_map.size(), std::pair<unsigned short, std::vector<unsigned int>>());
+            }
             for(unsigned short k = 0; k < _map.size(); ++k) {
                 std::vector<std::pair<unsigned int, unsigned int>> fast;
                 fast.reserve(_map[k].second.size());
@@ -226,6 +737,11 @@ class Subdomain {
                     }
                 }
                 std::sort(send[k].begin(), send[k].end());
+                if(cache) {
+                    _plan[k].reserve(send[k].size());
+                    for(const std::tuple<unsigned int, unsigned int, unsigned int>& t : send[k])
+                        _plan[k].emplace_back(std::get<2>(t));
+                }
                 sendSize[2 * k] = send[k].empty() ? 0 : 1;
                 for(unsigned int i = 1; i < send[k].size(); ++i)
                     if(std::get<0>(send[k][i]) != std::get<0>(send[k][i - 1]))
@@ -341,6 +857,10 @@ class Subdomain {
                         mapCol[ja[i]] = j++;
                 MatrixCSR<K>* AIJ = new MatrixCSR<K>(_dof, mapCol.size(), nnz, false);
                 v.emplace_back(AIJ);
+                if(cache) {
+                    _target[index].first = v.size() - 1;
+                    _target[index].second.resize(nnz);
+                }
                 std::fill(AIJ->_ia, AIJ->_ia + AIJ->_n + 1, 0);
                 for(unsigned int i = 0; i < recvSize[2 * index]; ++i) {
 #if 0
@@ -365,7 +885,13 @@ class Subdomain {
                             idx.emplace_back(j);
                         std::sort(idx.begin(), idx.end(), [&](const unsigned short& lhs, const unsigned short& rhs) { return AIJ->_ja[pos + lhs] < AIJ->_ja[pos + rhs]; });
                         reorder(idx, AIJ->_ja + pos, AIJ->_a + pos);
+                        if(cache)
+                            for(unsigned short j = 0; j < ia[i]; ++j)
+                                _target[index].second[m - ia[i] + idx[j]] = pos + j;
                     }
+                    else if(cache)
+                        for(unsigned short j = 0; j < ia[i]; ++j)
+                            _target[index].second[m - ia[i] + j] = pos + j;
                 }
             }
             MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
@@ -375,9 +901,57 @@ class Subdomain {
             else if(maxSend < _map.size())
                 delete [] sbuff[maxSend];
         }
+        /* Function: updateInteraction
+         *
+         *  Updates the values of the matrices built by a previous call to <Subdomain::interaction> with cache set to true, assuming the sparsity pattern of the input matrix is unchanged. Only values are exchanged, and the output matrices are not reallocated.
+         *
+         * Template Parameters:
+         *    N              - 0- or 1-based indexing of the input matrix.
+         *    scale          - True if the matrices must be scaled by the neighboring partition of unity.
+         *
+         * Parameters:
+         *    v              - Output vector.
+         *    scaling        - Local partition of unity.
+         *    pt             - Pointer to a <MatrixCSR>. */
+        template<char N, bool scale = false>
+        inline void updateInteraction(const std::vector<const MatrixCSR<K>*>& v, const typename Wrapper<K>::ul_type* const scaling = nullptr, const MatrixCSR<K, N>* const pt = nullptr) const {
+            assert(_plan.size() == _map.size() && _target.size() == _map.size() && v.size() == _map.size() && "Subdomain::interaction not previously called with cache set to true");
+            const MatrixCSR<K, N>& ref = pt ? *pt : *_a;
+            unsigned int size = 0;
+            for(unsigned short k = 0; k < _map.size(); ++k)
+                size += _plan[k].size() + _target[k].second.size();
+            K* const buffer = Workspace::get<K>(size);
+            std::vector<K*> recv;
+            recv.reserve(_map.size());
+            size = 0;
+            for(unsigned short k = 0; k < _map.size(); ++k) {
+                recv.emplace_back(buffer + size);
+                MPI_Irecv(recv.back(), _target[k].second.size(), Wrapper<K>::mpi_type(), _map[k].first, 100, _communicator, _rq + k);
+                size += _target[k].second.size();
+            }
+            for(unsigned short k = 0; k < _map.size(); ++k) {
+                K* const a = buffer + size;
+                for(unsigned int i = 0; i < _plan[k].size(); ++i) {
+                    a[i] = ref._a[_plan[k][i]];
+                    if(scale && scaling)
+                        a[i] *= scaling[ref._ja[_plan[k][i]]];
+                }
+                MPI_Isend(a, _plan[k].size(), Wrapper<K>::mpi_type(), _map[k].first, 100, _communicator, _rq + _map.size() + k);
+                size += _plan[k].size();
+            }
+            for(unsigned short k = 0; k < _map.size(); ++k) {
+                int index;
+                MPI_Waitany(_map.size(), _rq, &index, MPI_STATUS_IGNORE);
+                K* const a = const_cast<MatrixCSR<K>*>(v[_target[index].first])->_a;
+                for(unsigned int i = 0; i < _target[index].second.size(); ++i)
+                    a[_target[index].second[i]] = recv[index][i];
+            }
+            MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
+            Workspace::release(buffer);
+        }
         /* Function: globalMapping
          *
-         *  Computes a global numbering of all unknowns.
+         *  Computes a global numbering of all unknowns. Each unknown is numbered by the subdomain of lowest rank sharing it, among those with a partition of unity greater than 0.1 if provided, with an exclusive scan of the number of owned unknowns.
          *
          * Template Parameters:
          *    N              - 0- or 1-based indexing.
@@ -392,101 +966,66 @@ class Subdomain {
          *    d             - Local partition of unity (optional). */
         template<char N, class It>
         inline void globalMapping(It first, It last, unsigned int& start, unsigned int& end, unsigned int& global, const typename Wrapper<K>::ul_type* const d = nullptr) const {
-            unsigned int between = 0;
             int rankWorld, sizeWorld;
             MPI_Comm_rank(_communicator, &rankWorld);
             MPI_Comm_size(_communicator, &sizeWorld);
             if(sizeWorld > 1) {
-                for(unsigned short i = 0; i < _map.size() && _map[i].first < rankWorld; ++i)
-                    ++between;
-                unsigned int size = std::ceil(2 * (std::distance(_sbuff.front(), _sbuff.back()) + _map.back().second.size() + 1) * sizeof(unsigned int) / static_cast<float>(sizeof(K)));
-                unsigned int* rbuff = (size < std::distance(_rbuff[0], _sbuff.back()) + _map.back().second.size() ? reinterpret_cast<unsigned int*>(_rbuff[0]) : new unsigned int[2 * (std::distance(_sbuff.front(), _sbuff.back()) + _map.back().second.size() + 1)]);
-                unsigned int* sbuff = rbuff + std::distance(_sbuff.front(), _sbuff.back()) + _map.back().second.size() + 1;
-                size = 0;
-                MPI_Request* rq = new MPI_Request[2];
-
-                for(unsigned short i = 0; i < between; ++i) {
-                    MPI_Irecv(rbuff + size, _map[i].second.size() + (_map[i].first == rankWorld - 1), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + i);
-                    size += _map[i].second.size();
-                }
-
-                if(rankWorld && ((between && _map[between - 1].first != rankWorld - 1) || !between))
-                    MPI_Irecv(rbuff + size, 1, MPI_UNSIGNED, rankWorld - 1, 10, _communicator, rq);
-                else
-                    rq[0] = MPI_REQUEST_NULL;
-
-                ++size;
-                for(unsigned short i = between; i < _map.size(); ++i) {
-                    MPI_Irecv(rbuff + size, _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + _map.size() + i);
-                    size += _map[i].second.size();
+                for(unsigned int i = 0; i < std::distance(first, last); ++i)
+                    *(first + i) = (!d || d[i] > 0.1 ? 0 : std::numeric_limits<unsigned int>::max());
+                if(d) {
+                    for(unsigned short i = 0; i < _map.size(); ++i) {
+                        MPI_Irecv(reinterpret_cast<unsigned int*>(_rbuff[i]), _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + i);
+                        unsigned int* const sbuff = reinterpret_cast<unsigned int*>(_sbuff[i]);
+                        for(unsigned int j = 0; j < _map[i].second.size(); ++j)
+                            sbuff[j] = *(first + _map[i].second[j]);
+                        MPI_Isend(sbuff, _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + _map.size() + i);
+                    }
+                    MPI_Waitall(2 * _map.size(), _rq, MPI_STATUSES_IGNORE);
                 }
-
-                unsigned int begining;
-                std::fill(first, last, std::numeric_limits<unsigned int>::max());
-                if(rankWorld == 0) {
-                    begining = static_cast<unsigned int>(N == 'F');
-                    start = begining;
-                    for(unsigned int i = 0; i < std::distance(first, last); ++i)
-                        if(!d || d[i] > 0.1)
-                            *(first + i) = begining++;
-                    end = begining;
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    if(_map[i].first < rankWorld) {
+                        const unsigned int* const rbuff = reinterpret_cast<unsigned int*>(_rbuff[i]);
+                        for(unsigned int j = 0; j < _map[i].second.size(); ++j)
+                            if(!d || rbuff[j] == 0)
+                                *(first + _map[i].second[j]) = std::numeric_limits<unsigned int>::max();
+                    }
                 }
-                size = 0;
-                for(unsigned short i = 0; i < between; ++i) {
-                    MPI_Wait(_rq + i, MPI_STATUS_IGNORE);
+                unsigned int local = 0;
+                for(unsigned int i = 0; i < std::distance(first, last); ++i)
+                    if(*(first + i) == 0)
+                        ++local;
+                start = 0;
+                MPI_Exscan(&local, &start, 1, MPI_UNSIGNED, MPI_SUM, _communicator);
+                if(rankWorld == 0)
+                    start = 0;
+                start += (N == 'F');
+                end = start;
+                for(unsigned int i = 0; i < std::distance(first, last); ++i)
+                    if(*(first + i) == 0)
+                        *(first + i) = end++;
+                MPI_Request rq;
+#if (OMPI_MAJOR_VERSION > 1 || (OMPI_MAJOR_VERSION == 1 && OMPI_MINOR_VERSION >= 7)) || MPICH_NUMVERSION >= 30000000
+                MPI_Iallreduce(&local, &global, 1, MPI_UNSIGNED, MPI_SUM, _communicator, &rq);
+#else
+                MPI_Allreduce(&local, &global, 1, MPI_UNSIGNED, MPI_SUM, _communicator);
+                rq = MPI_REQUEST_NULL;
+#endif
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    MPI_Irecv(reinterpret_cast<unsigned int*>(_rbuff[i]), _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + i);
+                    unsigned int* const sbuff = reinterpret_cast<unsigned int*>(_sbuff[i]);
                     for(unsigned int j = 0; j < _map[i].second.size(); ++j)
-                        first[_map[i].second[j]] = rbuff[size + j];
-                    size += _map[i].second.size();
-                }
-                if(rankWorld) {
-                    if((between && _map[between - 1].first != rankWorld - 1) || !between)
-                        MPI_Wait(rq, MPI_STATUS_IGNORE);
-                    begining = rbuff[size];
-                    start = begining;
-                    for(unsigned int i = 0; i < std::distance(first, last); ++i)
-                        if((!d || d[i] > 0.1) && *(first + i) == std::numeric_limits<unsigned int>::max())
-                            *(first + i) = begining++;
-                    end = begining;
+                        sbuff[j] = *(first + _map[i].second[j]);
+                    MPI_Isend(sbuff, _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + _map.size() + i);
                 }
-                size = 0;
-                if(rankWorld != sizeWorld - 1) {
-                    if(_map[between].first == rankWorld + 1)
-                        sbuff[_map[between].second.size()] = begining;
-                    for(unsigned short i = between; i < _map.size(); ++i) {
-                        for(unsigned short j = 0; j < _map[i].second.size(); ++j)
-                            sbuff[size + j] = *(first + _map[i].second[j]);
-                        MPI_Isend(sbuff + size, _map[i].second.size() + (_map[i].first == rankWorld + 1), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + i);
-                        size += _map[i].second.size() + (_map[i].first == rankWorld + 1);
-                    }
-                    if(_map[between].first != rankWorld + 1)
-                        MPI_Isend(&begining, 1, MPI_UNSIGNED, rankWorld + 1, 10, _communicator, rq + 1);
-                    else
-                        rq[1] = MPI_REQUEST_NULL;
+                for(unsigned short i = 0; i < _map.size(); ++i) {
+                    int index;
+                    MPI_Waitany(_map.size(), _rq, &index, MPI_STATUS_IGNORE);
+                    const unsigned int* const rbuff = reinterpret_cast<unsigned int*>(_rbuff[index]);
+                    for(unsigned int j = 0; j < _map[index].second.size(); ++j)
+                        *(first + _map[index].second[j]) = std::min(*(first + _map[index].second[j]), rbuff[j]);
                 }
-                else
-                    rq[1] = MPI_REQUEST_NULL;
-                unsigned int stop = 0;
-                for(unsigned short i = 0; i < between; ++i) {
-                    for(unsigned short j = 0; j < _map[i].second.size(); ++j)
-                        sbuff[size + j] = *(first + _map[i].second[j]);
-                    MPI_Isend(sbuff + size, _map[i].second.size(), MPI_UNSIGNED, _map[i].first, 10, _communicator, _rq + _map.size() + i);
-                    size += _map[i].second.size();
-                    stop += _map[i].second.size();
-                }
-                ++stop;
-                for(unsigned short i = between; i < _map.size(); ++i) {
-                    MPI_Wait(_rq + _map.size() + i, MPI_STATUS_IGNORE);
-                    for(unsigned int j = 0; j < _map[i].second.size(); ++j)
-                        first[_map[i].second[j]] = rbuff[stop + j];
-                    stop += _map[i].second.size();
-                }
-                MPI_Waitall(_map.size(), _rq + between, MPI_STATUSES_IGNORE);
-                MPI_Waitall(2, rq, MPI_STATUSES_IGNORE);
-                delete [] rq;
-                if(rbuff != reinterpret_cast<unsigned int*>(_rbuff[0]))
-                    delete [] rbuff;
-                global = end - (N == 'F');
-                MPI_Bcast(&global, 1, MPI_UNSIGNED, sizeWorld - 1, _communicator);
+                MPI_Waitall(_map.size(), _rq + _map.size(), MPI_STATUSES_IGNORE);
+                MPI_Wait(&rq, MPI_STATUS_IGNORE);
             }
             else {
                 std::iota(first, last, static_cast<unsigned int>(N == 'F'));
@@ -0,0 +1,137 @@
+/*
+   This file is part of HPDDM.
+
+   Author(s): HPDDM contributors
+        Date: 2026-10-16
+
+   Copyright (C) 2026      HPDDM contributors
+
+   HPDDM is free software: you can redistribute it and/or modify
+   it under the terms of the GNU Lesser General Public License as published
+   by the Free Software Foundation, either version 3 of the License, or
+   (at your option) any later version.
+
+   HPDDM is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU Lesser General Public License for more details.
+
+   You should have received a copy of the GNU Lesser General Public License
+   along with HPDDM.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef _WORKSPACE_
+#define _WORKSPACE_
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <new>
+
+namespace HPDDM {
+/* Class: Workspace
+ *
+ *  A class that caches aligned buffers, so that temporary arrays of iterative methods and global operators are only allocated once for successive calls with similar sizes. Each thread owns its own cache, which keeps at most <HPDDM_CACHE> bytes of unused buffers. The pages of a new buffer are zeroed by the whole OpenMP team with a static schedule, so that they are not all placed in the memory of the allocating thread. */
+class Workspace {
+    private:
+        /* Variable: free
+         *  Buffers available for reuse, with their sizes in bytes. */
+        std::vector<std::pair<std::size_t, void*>> _free;
+        /* Variable: used
+         *  Buffers currently in use, with their sizes in bytes. */
+        std::vector<std::pair<std::size_t, void*>>  _used;
+        /* Variable: cached
+         *  Total size in bytes of <Workspace::free>. */
+        std::size_t                               _cached;
+        Workspace() : _cached() { }
+        ~Workspace() {
+            for(const std::pair<std::size_t, void*>& p : _free)
+                std::free(p.second);
+            for(const std::pair<std::size_t, void*>& p : _used)
+                std::free(p.second);
+        }
+        /* Function: instance
+         *  Returns the cache of the calling thread. */
+        static Workspace& instance() {
+            static thread_local Workspace w;
+            return w;
+        }
+        /* Function: acquire
+         *  Returns a buffer of at least size bytes, reusing a cached buffer whose size is at most twice as large, or allocating a new one. */
+        void* acquire(std::size_t size, bool& fresh) {
+            std::vector<std::pair<std::size_t, void*>>::iterator best = _free.end();
+            for(std::vector<std::pair<std::size_t, void*>>::iterator it = _free.begin(); it != _free.end(); ++it)
+                if(it->first >= size && it->first / 2 <= size && (best == _free.end() || it->first < best->first))
+                    best = it;
+            fresh = (best == _free.end());
+            if(fresh) {
+                void* pt = nullptr;
+                size = std::max(size + HPDDM_ALIGN - 1 - (size + HPDDM_ALIGN - 1) % HPDDM_ALIGN, static_cast<std::size_t>(HPDDM_ALIGN));
+                if(posix_memalign(&pt, HPDDM_ALIGN, size))
+                    throw std::bad_alloc();
+                const std::size_t pages = (size + 4095) / 4096;
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < pages; ++i)
+                    std::memset(static_cast<char*>(pt) + i * 4096, 0, std::min(size - i * 4096, static_cast<std::size_t>(4096)));
+                _used.emplace_back(size, pt);
+            }
+            else {
+                _cached -= best->first;
+                _used.emplace_back(*best);
+                _free.erase(best);
+            }
+            return _used.back().second;
+        }
+    public:
+        Workspace(const Workspace&) = delete;
+        /* Function: get
+         *
+         *  Returns an aligned array from the cache of the calling thread.
+         *
+         * Template Parameter:
+         *    K              - Scalar type.
+         *
+         * Parameters:
+         *    n              - Number of scalars.
+         *    zero           - True if the array must be initialized to zero, false otherwise. */
+        template<class K>
+        static K* get(std::size_t n, bool zero = false) {
+            bool fresh;
+            K* const pt = static_cast<K*>(instance().acquire(std::max(n, static_cast<std::size_t>(1)) * sizeof(K), fresh));
+            if(zero && !fresh)
+                std::fill_n(pt, n, K());
+            return pt;
+        }
+        /* Function: release
+         *  Gives back to the cache of the calling thread an array obtained with <Workspace::get> by the same thread. The least recently released arrays are freed while the cache holds more than <HPDDM_CACHE> bytes. */
+        template<class K>
+        static void release(K* const pt) {
+            if(pt) {
+                Workspace& w = instance();
+                std::vector<std::pair<std::size_t, void*>>::reverse_iterator it = std::find_if(w._used.rbegin(), w._used.rend(), [&](const std::pair<std::size_t, void*>& p) { return p.second == pt; });
+                assert(it != w._used.rend() && "Array not obtained with Workspace::get by this thread");
+                if(it != w._used.rend()) {
+                    w._cached += it->first;
+                    w._free.emplace_back(*it);
+                    w._used.erase(std::next(it).base());
+                    while(w._cached > HPDDM_CACHE) {
+                        w._cached -= w._free.front().first;
+                        std::free(w._free.front().second);
+                        w._free.erase(w._free.begin());
+                    }
+                }
+            }
+        }
+        /* Function: clear
+         *  Frees all cached arrays of the calling thread that are not in use. */
+        static void clear() {
+            Workspace& w = instance();
+            for(const std::pair<std::size_t, void*>& p : w._free)
+                std::free(p.second);
+            w._free.clear();
+            w._cached = 0;
+        }
+};
+} // HPDDM
+#endif // _WORKSPACE_
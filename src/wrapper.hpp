@@ -36,6 +36,21 @@ struct underlying_type_spec<std::complex<T>> {
 
 template <class T>
 using underlying_type = typename underlying_type_spec<T>::type;
+template<class T>
+struct downscaled_type_spec {
+    typedef T type;
+};
+template<>
+struct downscaled_type_spec<double> {
+    typedef float type;
+};
+template<>
+struct downscaled_type_spec<std::complex<double>> {
+    typedef std::complex<float> type;
+};
+
+template <class T>
+using downscaled_type = typename downscaled_type_spec<T>::type;
 /* Class: Wrapper
  *
  *  A class for handling all dense and sparse linear algebra.
@@ -82,6 +97,10 @@ class Wrapper {
         /* Function: lacpy
          *  Copies all or part of a two-dimensional matrix. */
         static inline void lacpy(const char* const, const int* const, const int* const, const K* const, const int* const, K* const, const int* const);
+        /* Function: geev
+         *  Computes the eigenvalues and the right or left eigenvectors of a general matrix. The eigenvalues of real matrices are returned as real and imaginary parts, while the array of imaginary parts and the last workspace array are not referenced for complex matrices. */
+        static inline void geev(const char* const, const char* const, const int* const, K* const, const int* const, K* const, K* const, K* const, const int* const,
+                                K* const, const int* const, K* const, const int* const, ul_type* const, int* const);
 
         /* Function: symv
          *  Computes a symmetric scalar-matrix-vector product. */
@@ -100,6 +119,10 @@ class Wrapper {
          *  Computes a scalar-matrix-matrix product. */
         static inline void gemm(const char* const, const char* const, const int* const, const int* const, const int* const, const K* const, const K* const,
                                 const int* const, const K* const, const int* const, const K* const, K* const, const int* const);
+        /* Function: trsm
+         *  Solves a triangular system of equations with multiple right-hand sides. */
+        static inline void trsm(const char* const, const char* const, const char* const, const char* const, const int* const, const int* const,
+                                const K* const, const K* const, const int* const, K* const, const int* const);
 
         /* Function: csrmv(square)
          *  Computes a sparse square matrix-vector product. */
@@ -161,6 +184,10 @@ template<>
 inline MPI_Datatype Wrapper<std::complex<float>>::mpi_type() { return MPI_COMPLEX; }
 template<>
 inline MPI_Datatype Wrapper<std::complex<double>>::mpi_type() { return MPI_DOUBLE_COMPLEX; }
+template<>
+inline MPI_Datatype Wrapper<unsigned short>::mpi_type() { return MPI_UNSIGNED_SHORT; }
+template<>
+inline MPI_Datatype Wrapper<unsigned int>::mpi_type() { return MPI_UNSIGNED; }
 
 template<class K>
 const char Wrapper<K>::transc = std::is_same<K, ul_type>::value ? 'T' : 'C';
@@ -219,6 +246,13 @@ inline void Wrapper<T>::gemm(const char* const transa, const char* const transb,
                              const T* const b, const int* const ldb, const T* const beta,                    \
                              T* const c, const int* const ldc) {                                             \
     HPDDM_F77(C ## gemm)(transa, transb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);                      \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::trsm(const char* const side, const char* const uplo, const char* const transa,       \
+                             const char* const diag, const int* const m, const int* const n,                 \
+                             const T* const alpha, const T* const a, const int* const lda,                   \
+                             T* const b, const int* const ldb) {                                             \
+    HPDDM_F77(C ## trsm)(side, uplo, transa, diag, m, n, alpha, a, lda, b, ldb);                             \
 }
 #if HPDDM_MKL || defined(__APPLE__)
 #define HPDDM_GENERATE_DOTC(C, T, U)                                                                         \
@@ -263,6 +297,20 @@ inline U Wrapper<U>::dot(const int* const n, const U* const x, const int* const
                          const U* const y, const int* const incy) {                                          \
     return HPDDM_F77(B ## dot)(n, x, incx, y, incy);                                                         \
 }                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<U>::geev(const char* const jobvl, const char* const jobvr, const int* const n,           \
+                             U* const a, const int* const lda, U* const wr, U* const wi, U* const vl,        \
+                             const int* const ldvl, U* const vr, const int* const ldvr, U* const work,       \
+                             const int* const lwork, U* const, int* const info) {                            \
+    HPDDM_F77(B ## geev)(jobvl, jobvr, n, a, lda, wr, wi, vl, ldvl, vr, ldvr, work, lwork, info);            \
+}                                                                                                            \
+template<>                                                                                                   \
+inline void Wrapper<T>::geev(const char* const jobvl, const char* const jobvr, const int* const n,           \
+                             T* const a, const int* const lda, T* const w, T* const, T* const vl,            \
+                             const int* const ldvl, T* const vr, const int* const ldvr, T* const work,       \
+                             const int* const lwork, U* const rwork, int* const info) {                      \
+    HPDDM_F77(C ## geev)(jobvl, jobvr, n, a, lda, w, vl, ldvl, vr, ldvr, work, lwork, rwork, info);          \
+}                                                                                                            \
 HPDDM_GENERATE_DOTC(C, T, U)
 HPDDM_GENERATE_BLAS(s, float)
 HPDDM_GENERATE_BLAS(d, double)